@@ -0,0 +1,31 @@
+#include "llvm/Support/Casting.h"
+#include"catalog.h"
+
+bool table_schema::declared_by(const StatementAST& stmt, table_schema& out)
+{
+	auto create = llvm::dyn_cast<CreateTableSimpleAST>(&stmt);
+	if (!create)
+		return false;
+	out.name = create->table_name;
+	out.cols.clear();
+	for (auto& def : create->create_defs)
+	{
+		if (!def)
+			return false;
+		column_def col;
+		col.name = def->col_name;
+		col.dtype = def->dtype;
+		col.width = def->dtype == literal_string ? def->n : 0;
+		out.cols.push_back(col);
+	}
+	return true;
+}
+
+void schema_catalog::apply(const StatementAST& stmt)
+{
+	table_schema table;
+	if (table_schema::declared_by(stmt, table))
+		add(std::move(table));
+	else if (table.name != no_atom)
+		drop(table.name);	// replaced by a table we cannot describe
+}
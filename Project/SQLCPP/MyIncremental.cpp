@@ -0,0 +1,270 @@
+#include<algorithm>
+#include<cstring>
+#include"incremental.h"
+#include"scan_source.h"
+
+// how far past its end a token may look before it is decided:
+// 5e-3 reads e, - and 3 before it knows whether the number is just 5
+constexpr std::size_t lex_lookahead = 3;
+
+static bool ends_statement(const token_buffer& b, std::size_t i)
+{
+	return (b.kinds[i] == symbol && b.payload[i] == semicolon_mark) || b.kinds[i] == lex_error;
+}
+
+std::string incremental_script::where(std::uint64_t at) const
+{
+	memory_source src(source.data(), source.data() + source.size(), dropped_bytes, dropped_lines, line_start);
+	source_location loc = src.locate(dropped_bytes + at);
+	return " at line " + std::to_string(loc.line) + ", column " + std::to_string(loc.column);
+}
+
+incremental_script::incremental_script(std::string text) :source(std::move(text))
+{
+	rebuild();
+}
+
+void incremental_script::rebuild()
+{
+	toks.clear();
+	Scanner scanner(llvm::make_unique<memory_source>(source.data(), source.data() + source.size()));
+	scanner.set_recover(true);
+	toks.fill_all(scanner);
+
+	stmts.clear();
+	for (std::size_t i = 0; i < toks.size();)
+	{
+		statement s;
+		s.first = i;
+		while (i < toks.size() && !ends_statement(toks, i))
+			++i;
+		s.complete = i < toks.size() && toks.kinds[i] != lex_error;
+		i += i < toks.size();
+		s.count = i - s.first;
+		parse(s);
+		stmts.push_back(std::move(s));
+	}
+	relexed_tokens = toks.size();
+	reparsed_statements = stmts.size();
+	reused_statements = 0;
+}
+
+void incremental_script::parse(statement& s)
+{
+	s.ast = nullptr;
+	s.error.clear();
+	s.reused = false;
+	// the string or comment is open to the end of the text, the error is
+	// there for an editor to show while the statement stays incomplete
+	std::size_t last = s.first + s.count - 1;
+	if (toks.kinds[last] == lex_error)
+	{
+		token t = toks.at(last);
+		s.error = lex_error_reason(t) + where(t.offset);
+		return;
+	}
+	// still being typed, or just a ';'
+	if (!s.complete || (s.count == 1 && toks.kinds[s.first] == symbol))
+		return;
+	Parser parser(toks);
+	parser.init(s.first);
+	try
+	{
+		s.ast = parser.ParseStatementAST();
+	}
+	catch (syntax_error& e)
+	{
+		s.error = e.reason + where(e.offset);
+	}
+}
+
+void incremental_script::edit(std::size_t at, std::size_t removed, llvm::StringRef inserted)
+{
+	at = std::min(at, source.size());
+	removed = std::min(removed, source.size() - at);
+	source.replace(at, removed, inserted.data(), inserted.size());
+	std::int64_t delta = static_cast<std::int64_t>(inserted.size()) - static_cast<std::int64_t>(removed);
+
+	// the string pool only grows, start over once it is mostly dead text
+	if (toks.text.size() > 2 * source.size() + 4096)
+	{
+		rebuild();
+		return;
+	}
+
+	// restart at a token whose predecessors did not look at the changed bytes,
+	// and before any lex_error, since that one looked all the way to the end
+	std::size_t r = 0;
+	std::uint64_t restart = 0;
+	if (at >= lex_lookahead)
+	{
+		auto k = std::upper_bound(toks.offsets.begin(), toks.offsets.end(), at - lex_lookahead);
+		if (k != toks.offsets.begin())
+		{
+			r = k - toks.offsets.begin() - 1;
+			restart = toks.offsets[r];
+		}
+	}
+	auto bad = std::find(toks.kinds.begin(), toks.kinds.begin() + r, static_cast<std::uint8_t>(lex_error));
+	if (bad != toks.kinds.begin() + r)
+	{
+		r = bad - toks.kinds.begin();
+		restart = toks.offsets[r];
+	}
+
+	// lex until a token starts where an old one did, shifted by delta;
+	// from there on the scanner would produce the old tokens again
+	token_buffer fresh;
+	std::size_t j = toks.size();
+	Scanner scanner(llvm::make_unique<memory_source>(source.data() + restart, source.data() + source.size(), restart));
+	scanner.set_recover(true);
+	for (token t = scanner.gettok(); t.token_kind != eof; t = scanner.gettok())
+	{
+		if (t.offset >= at + inserted.size())
+		{
+			std::uint64_t old_at = t.offset - delta;
+			auto k = std::lower_bound(toks.offsets.begin() + r, toks.offsets.end(), old_at);
+			if (k != toks.offsets.end() && *k == old_at)
+			{
+				j = k - toks.offsets.begin();
+				break;
+			}
+		}
+		fresh.push(t);
+	}
+
+	// tokens [r, j) are replaced by fresh
+	std::size_t m = fresh.size(), pool = toks.text.size();
+	auto splice = [&](auto& old, const auto& mid)
+	{
+		old.erase(old.begin() + r, old.begin() + j);
+		old.insert(old.begin() + r, mid.begin(), mid.end());
+	};
+	splice(toks.kinds, fresh.kinds);
+	splice(toks.lengths, fresh.lengths);
+	splice(toks.payload, fresh.payload);
+	splice(toks.offsets, fresh.offsets);
+	toks.text += fresh.text;
+	for (std::size_t i = r; i < r + m; ++i)
+		if (toks.kinds[i] == literal_string || toks.kinds[i] == lex_error)
+			toks.payload[i] += pool;
+	for (std::size_t i = r + m; i < toks.size(); ++i)
+		toks.offsets[i] += delta;
+	relexed_tokens = m;
+
+	// statements that end before r are untouched; after the relexed tokens,
+	// one that starts where an old one did (shifted) is the same statement
+	std::vector<statement> old = std::move(stmts);
+	stmts.clear();
+	std::size_t p = 0;
+	while (p < old.size() && old[p].complete && old[p].first + old[p].count <= r)
+		stmts.push_back(std::move(old[p++]));
+	for (auto& s : stmts)
+		s.reused = true;
+	reused_statements = stmts.size();
+	reparsed_statements = 0;
+
+	std::int64_t shift = static_cast<std::int64_t>(r + m) - static_cast<std::int64_t>(j);
+	std::size_t i = stmts.empty() ? 0 : stmts.back().first + stmts.back().count;
+	while (i < toks.size())
+	{
+		if (i >= r + m)
+		{
+			std::size_t was = i - shift;
+			auto k = std::lower_bound(old.begin() + p, old.end(), was,
+				[](const statement& s, std::size_t first) { return s.first < first; });
+			if (k != old.end() && k->first == was)
+			{
+				// the rest lines up with the old statements one for one;
+				// errors are made again, their line numbers may have moved
+				for (; k != old.end(); ++k)
+				{
+					k->first += shift;
+					if (k->error.empty())
+					{
+						k->reused = true;
+						++reused_statements;
+					}
+					else
+					{
+						parse(*k);
+						++reparsed_statements;
+					}
+					stmts.push_back(std::move(*k));
+				}
+				break;
+			}
+		}
+		statement s;
+		s.first = i;
+		while (i < toks.size() && !ends_statement(toks, i))
+			++i;
+		s.complete = i < toks.size() && toks.kinds[i] != lex_error;
+		i += i < toks.size();
+		s.count = i - s.first;
+		parse(s);
+		stmts.push_back(std::move(s));
+		++reparsed_statements;
+	}
+}
+
+bool incremental_script::take_complete(const std::function<void(const statement&)>& run)
+{
+	for (const statement& s : stmts)
+	{
+		std::uint64_t at = toks.offsets[s.first];
+		if (at < taken_to)
+			continue;
+		if (!s.complete)
+			return true;
+		taken_to = at + 1;
+		run(s);
+	}
+	return false;
+}
+
+void incremental_script::drop_taken()
+{
+	std::size_t q = 0;
+	while (q < stmts.size() && stmts[q].complete && toks.offsets[stmts[q].first] < taken_to)
+		++q;
+	if (q == 0)
+		return;
+	// up to and including the ';' of the last one handed out
+	std::size_t t = stmts[q - 1].first + stmts[q - 1].count;
+	std::uint64_t cut = toks.offsets[t - 1] + 1;
+
+	for (const char* p = source.data(), *lim = p + cut; p < lim; ++p)
+	{
+		p = static_cast<const char*>(memchr(p, '\n', lim - p));
+		if (!p)
+			break;
+		++dropped_lines;
+		line_start = dropped_bytes + (p - source.data()) + 1;
+	}
+	dropped_bytes += cut;
+	source.erase(0, cut);
+	taken_to = taken_to > cut ? taken_to - cut : 0;
+
+	auto drop = [&](auto& v) { v.erase(v.begin(), v.begin() + t); };
+	drop(toks.kinds);
+	drop(toks.lengths);
+	drop(toks.payload);
+	drop(toks.offsets);
+	for (auto& o : toks.offsets)
+		o -= cut;
+	// the string pool keeps only the text of the tokens left
+	std::string text;
+	for (std::size_t i = 0; i < toks.size(); ++i)
+		if (toks.kinds[i] == literal_string || toks.kinds[i] == lex_error)
+		{
+			std::size_t from = static_cast<std::size_t>(toks.payload[i]);
+			toks.payload[i] = static_cast<std::int64_t>(text.size());
+			text.append(toks.text, from, toks.lengths[i]);
+		}
+	toks.text = std::move(text);
+
+	stmts.erase(stmts.begin(), stmts.begin() + q);
+	for (auto& s : stmts)
+		s.first -= t;
+}
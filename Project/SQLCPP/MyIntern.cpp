@@ -0,0 +1,105 @@
+#include<atomic>
+#include<cstring>
+#include<memory>
+#include<mutex>
+#include<stdexcept>
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Allocator.h"
+#include"intern.h"
+
+// The table is split into shards by hash, each with its own lock.  An atom
+// is (1 + index within its shard) << shard_bits | shard, and the spellings of
+// a shard sit in fixed-size blocks that never move, so atom_text() reads
+// without taking any lock: whoever holds an atom got it after the block
+// was written.
+
+constexpr unsigned shard_bits = 5;
+constexpr unsigned shard_count = 1u << shard_bits;
+constexpr unsigned block_bits = 12;
+constexpr unsigned block_size = 1u << block_bits;
+constexpr unsigned max_blocks = 1u << 10;
+
+struct intern_shard
+{
+	std::mutex lock;
+	llvm::StringMap<atom, llvm::BumpPtrAllocator> index;
+	std::unique_ptr<llvm::StringRef[]> blocks[max_blocks];
+	std::uint32_t count = 0;
+};
+
+static intern_shard* intern_shards()
+{
+	static intern_shard* shards = new intern_shard[shard_count];	// never freed, atoms outlive statics
+	return shards;
+}
+
+static std::atomic<std::size_t> atom_total{ 0 };
+
+static std::uint32_t intern_hash(llvm::StringRef s)
+{
+	std::uint32_t x = 2166136261u;
+	for (char c : s)
+		x = (x ^ static_cast<unsigned char>(c)) * 16777619u;
+	return x;
+}
+
+static atom intern_slow(llvm::StringRef s, std::uint32_t hash)
+{
+	unsigned shard = hash >> (32 - shard_bits);
+	intern_shard& sh = intern_shards()[shard];
+	std::lock_guard<std::mutex> hold(sh.lock);
+
+	auto found = sh.index.find(s);
+	if (found != sh.index.end())
+		return found->second;
+
+	std::uint32_t i = sh.count;
+	if (i >= block_size * max_blocks)
+		throw std::length_error("too many identifiers");
+	auto& block = sh.blocks[i >> block_bits];
+	if (!block)
+		block.reset(new llvm::StringRef[block_size]);
+	auto entry = sh.index.insert(std::make_pair(s, no_atom)).first;
+	atom a = ((i + 1) << shard_bits) | shard;
+	entry->second = a;
+	// the key stored in the map is the copy that atom_text() hands out
+	block[i & (block_size - 1)] = entry->first();
+	++sh.count;
+	++atom_total;
+	return a;
+}
+
+// a small direct-mapped cache per thread, no lock taken on a hit
+struct intern_cache_entry
+{
+	std::uint32_t hash = 0;
+	atom a = no_atom;
+};
+
+constexpr unsigned intern_cache_size = 4096;
+
+atom intern(llvm::StringRef s)
+{
+	static thread_local intern_cache_entry cache[intern_cache_size];
+
+	std::uint32_t hash = intern_hash(s);
+	intern_cache_entry& e = cache[hash & (intern_cache_size - 1)];
+	if (e.a != no_atom && e.hash == hash && atom_text(e.a) == s)
+		return e.a;
+	e.hash = hash;
+	e.a = intern_slow(s, hash);
+	return e.a;
+}
+
+llvm::StringRef atom_text(atom a)
+{
+	if (a == no_atom)
+		return llvm::StringRef();
+	std::uint32_t i = (a >> shard_bits) - 1;
+	return intern_shards()[a & (shard_count - 1)].blocks[i >> block_bits][i & (block_size - 1)];
+}
+
+std::size_t atom_count()
+{
+	return atom_total;
+}
@@ -0,0 +1,298 @@
+#include<cstdlib>
+#include<cstring>
+#include"scan_kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SCAN_X86 1
+#include<immintrin.h>
+#ifdef _MSC_VER
+#include<intrin.h>
+#define SCAN_TARGET(isa)
+#else
+#define SCAN_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+inline bool is_blank(char c)
+{
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline unsigned first_bit(unsigned mask)
+{
+#ifdef _MSC_VER
+	unsigned long i;
+	_BitScanForward(&i, mask);
+	return i;
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+/// scalar
+
+static const char* scalar_skip_space(const char* p, const char* lim)
+{
+	while (p < lim && is_blank(*p))
+		++p;
+	return p;
+}
+
+static const char* scalar_find_newline(const char* p, const char* lim)
+{
+	while (p < lim && *p != '\n' && *p != '\r')
+		++p;
+	return p;
+}
+
+static const char* scalar_find_comment_end(const char* p, const char* lim)
+{
+	while (p < lim)
+	{
+		const char* star = static_cast<const char*>(memchr(p, '*', lim - p));
+		if (!star || star + 1 == lim || star[1] == '/')
+			return star ? star : lim;
+		p = star + 1;
+	}
+	return lim;
+}
+
+static const char* scalar_find_quote(const char* p, const char* lim, char quote)
+{
+	while (p < lim && *p != quote && *p != '\\')
+		++p;
+	return p;
+}
+
+static const char* scalar_find_code_mark(const char* p, const char* lim)
+{
+	while (p < lim && *p != ';' && *p != '\'' && *p != '"' && *p != '#' && *p != '-' && *p != '/')
+		++p;
+	return p;
+}
+
+#ifdef SCAN_X86
+
+/// SSE4.2: pcmpestri matches against a small character set per 16 bytes
+
+SCAN_TARGET("sse4.2")
+static const char* sse42_skip_space(const char* p, const char* lim)
+{
+	const __m128i set = _mm_setr_epi8(' ', '\t', '\n', '\v', '\f', '\r', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+	for (; lim - p >= 16; p += 16)
+	{
+		int i = _mm_cmpestri(set, 6, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), 16,
+			_SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_NEGATIVE_POLARITY);
+		if (i < 16)
+			return p + i;
+	}
+	return scalar_skip_space(p, lim);
+}
+
+SCAN_TARGET("sse4.2")
+static const char* sse42_find_newline(const char* p, const char* lim)
+{
+	const __m128i set = _mm_setr_epi8('\n', '\r', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+	for (; lim - p >= 16; p += 16)
+	{
+		int i = _mm_cmpestri(set, 2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), 16,
+			_SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY);
+		if (i < 16)
+			return p + i;
+	}
+	return scalar_find_newline(p, lim);
+}
+
+SCAN_TARGET("sse4.2")
+static const char* sse42_find_comment_end(const char* p, const char* lim)
+{
+	// ordered compare also reports a "*" cut off by the end of the block
+	const __m128i needle = _mm_setr_epi8('*', '/', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+	while (lim - p >= 16)
+	{
+		int i = _mm_cmpestri(needle, 2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), 16,
+			_SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ORDERED);
+		if (i < 15)
+			return p + i;
+		p += i == 15 ? 15 : 16;
+	}
+	return scalar_find_comment_end(p, lim);
+}
+
+SCAN_TARGET("sse4.2")
+static const char* sse42_find_quote(const char* p, const char* lim, char quote)
+{
+	const __m128i set = _mm_setr_epi8(quote, '\\', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+	for (; lim - p >= 16; p += 16)
+	{
+		int i = _mm_cmpestri(set, 2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), 16,
+			_SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY);
+		if (i < 16)
+			return p + i;
+	}
+	return scalar_find_quote(p, lim, quote);
+}
+
+SCAN_TARGET("sse4.2")
+static const char* sse42_find_code_mark(const char* p, const char* lim)
+{
+	const __m128i set = _mm_setr_epi8(';', '\'', '"', '#', '-', '/', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+	for (; lim - p >= 16; p += 16)
+	{
+		int i = _mm_cmpestri(set, 6, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), 16,
+			_SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY);
+		if (i < 16)
+			return p + i;
+	}
+	return scalar_find_code_mark(p, lim);
+}
+
+/// AVX2: byte compares and movemask per 32 bytes
+
+SCAN_TARGET("avx2")
+static const char* avx2_skip_space(const char* p, const char* lim)
+{
+	const __m256i space = _mm256_set1_epi8(' '), tab = _mm256_set1_epi8('\t'), four = _mm256_set1_epi8(4);
+	for (; lim - p >= 32; p += 32)
+	{
+		__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		// \t..\r is one range: (x - '\t') <= 4 unsigned
+		__m256i d = _mm256_sub_epi8(x, tab);
+		__m256i blank = _mm256_or_si256(_mm256_cmpeq_epi8(x, space),
+			_mm256_cmpeq_epi8(_mm256_min_epu8(d, four), d));
+		unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(blank));
+		if (mask)
+			return p + first_bit(mask);
+	}
+	return scalar_skip_space(p, lim);
+}
+
+SCAN_TARGET("avx2")
+static const char* avx2_find_newline(const char* p, const char* lim)
+{
+	const __m256i lf = _mm256_set1_epi8('\n'), cr = _mm256_set1_epi8('\r');
+	for (; lim - p >= 32; p += 32)
+	{
+		__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+			_mm256_or_si256(_mm256_cmpeq_epi8(x, lf), _mm256_cmpeq_epi8(x, cr))));
+		if (mask)
+			return p + first_bit(mask);
+	}
+	return scalar_find_newline(p, lim);
+}
+
+SCAN_TARGET("avx2")
+static const char* avx2_find_comment_end(const char* p, const char* lim)
+{
+	const __m256i star = _mm256_set1_epi8('*'), slash = _mm256_set1_epi8('/');
+	for (; lim - p >= 33; p += 32)
+	{
+		__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 1));
+		unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+			_mm256_and_si256(_mm256_cmpeq_epi8(x, star), _mm256_cmpeq_epi8(y, slash))));
+		if (mask)
+			return p + first_bit(mask);
+	}
+	return scalar_find_comment_end(p, lim);
+}
+
+SCAN_TARGET("avx2")
+static const char* avx2_find_quote(const char* p, const char* lim, char quote)
+{
+	const __m256i q = _mm256_set1_epi8(quote), backslash = _mm256_set1_epi8('\\');
+	for (; lim - p >= 32; p += 32)
+	{
+		__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+			_mm256_or_si256(_mm256_cmpeq_epi8(x, q), _mm256_cmpeq_epi8(x, backslash))));
+		if (mask)
+			return p + first_bit(mask);
+	}
+	return scalar_find_quote(p, lim, quote);
+}
+
+SCAN_TARGET("avx2")
+static const char* avx2_find_code_mark(const char* p, const char* lim)
+{
+	const __m256i semicolon = _mm256_set1_epi8(';'), squote = _mm256_set1_epi8('\''), dquote = _mm256_set1_epi8('"'),
+		hash = _mm256_set1_epi8('#'), dash = _mm256_set1_epi8('-'), slash = _mm256_set1_epi8('/');
+	for (; lim - p >= 32; p += 32)
+	{
+		__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		__m256i hit = _mm256_or_si256(
+			_mm256_or_si256(_mm256_cmpeq_epi8(x, semicolon), _mm256_cmpeq_epi8(x, squote)),
+			_mm256_or_si256(_mm256_cmpeq_epi8(x, dquote), _mm256_cmpeq_epi8(x, hash)));
+		hit = _mm256_or_si256(hit, _mm256_or_si256(_mm256_cmpeq_epi8(x, dash), _mm256_cmpeq_epi8(x, slash)));
+		unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hit));
+		if (mask)
+			return p + first_bit(mask);
+	}
+	return scalar_find_code_mark(p, lim);
+}
+
+#ifdef _MSC_VER
+static bool cpu_has_sse42()
+{
+	int r[4];
+	__cpuid(r, 1);
+	return (r[2] & (1 << 20)) != 0;
+}
+
+static bool cpu_has_avx2()
+{
+	int r[4];
+	__cpuid(r, 0);
+	if (r[0] < 7)
+		return false;
+	__cpuid(r, 1);
+	// AVX and OSXSAVE, then the OS has to save the ymm state
+	if ((r[2] & (1 << 27)) == 0 || (r[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+		return false;
+	__cpuidex(r, 7, 0);
+	return (r[1] & (1 << 5)) != 0;
+}
+#else
+static bool cpu_has_sse42()
+{
+	return __builtin_cpu_supports("sse4.2");
+}
+
+static bool cpu_has_avx2()
+{
+	return __builtin_cpu_supports("avx2");
+}
+#endif
+
+#endif // SCAN_X86
+
+static const scan_kernels scalar_kernels = { "scalar", scalar_skip_space, scalar_find_newline, scalar_find_comment_end,
+	scalar_find_quote, scalar_find_code_mark };
+#ifdef SCAN_X86
+static const scan_kernels sse42_kernels = { "sse42", sse42_skip_space, sse42_find_newline, sse42_find_comment_end,
+	sse42_find_quote, sse42_find_code_mark };
+static const scan_kernels avx2_kernels = { "avx2", avx2_skip_space, avx2_find_newline, avx2_find_comment_end,
+	avx2_find_quote, avx2_find_code_mark };
+#endif
+
+static const scan_kernels& pick_scan_kernels()
+{
+	const char* want = getenv("LLVMSQL_SCAN_KERNELS");
+	if (want && strcmp(want, "scalar") == 0)
+		return scalar_kernels;
+#ifdef SCAN_X86
+	bool any = !want || !*want;
+	if ((any || strcmp(want, "avx2") == 0) && cpu_has_avx2())
+		return avx2_kernels;
+	if ((any || strcmp(want, "avx2") == 0 || strcmp(want, "sse42") == 0) && cpu_has_sse42())
+		return sse42_kernels;
+#endif
+	return scalar_kernels;
+}
+
+const scan_kernels& select_scan_kernels()
+{
+	static const scan_kernels& chosen = pick_scan_kernels();
+	return chosen;
+}
@@ -0,0 +1,212 @@
+#include<algorithm>
+#include<cstring>
+#include"scan_kernels.h"
+#include"scan_parallel.h"
+#include"scan_source.h"
+
+// where the pre-pass is at a piece boundary
+// the boundaries are placed so that no two-byte sequence (-- /* */ \x) is cut,
+// which leaves only these states
+enum split_state
+{
+	in_code,
+	in_single_quote,
+	in_double_quote,
+	in_line_comment,
+	in_block_comment,
+	split_states
+};
+
+struct piece_scan
+{
+	split_state end = in_code;
+	const char* split = nullptr;	// one past the first ';' seen in code
+};
+
+static piece_scan scan_piece(const scan_kernels& kernels, const char* p, const char* lim, split_state s)
+{
+	piece_scan r;
+	while (p < lim)
+	{
+		switch (s)
+		{
+		case in_code:
+		{
+			p = kernels.find_code_mark(p, lim);
+			if (p == lim)
+				break;
+			char c = *p++;
+			if (c == ';')
+			{
+				if (!r.split)
+					r.split = p;
+			}
+			else if (c == '\'')
+				s = in_single_quote;
+			else if (c == '"')
+				s = in_double_quote;
+			else if (c == '#')
+				s = in_line_comment;
+			else if (c == '-' && p < lim && *p == '-')
+			{
+				++p;
+				s = in_line_comment;
+			}
+			else if (c == '/' && p < lim && *p == '*')
+			{
+				++p;
+				s = in_block_comment;
+			}
+			break;
+		}
+		case in_single_quote:
+		case in_double_quote:
+			// '' and "" close and reopen, which ends in the same state
+			p = kernels.find_quote(p, lim, s == in_single_quote ? '\'' : '"');
+			if (p == lim)
+				break;
+			if (*p == '\\')
+				p = std::min(p + 2, lim);
+			else
+			{
+				++p;
+				s = in_code;
+			}
+			break;
+		case in_line_comment:
+			p = kernels.find_newline(p, lim);
+			if (p < lim)
+			{
+				++p;
+				s = in_code;
+			}
+			break;
+		case in_block_comment:
+			p = kernels.find_comment_end(p, lim);
+			if (lim - p < 2)
+				p = lim;
+			else
+			{
+				p += 2;
+				s = in_code;
+			}
+			break;
+		default:
+			p = lim;
+			break;
+		}
+	}
+	r.end = s;
+	return r;
+}
+
+// first byte at or after p whose predecessor cannot start a two-byte sequence
+static const char* piece_boundary(const char* begin, const char* p, const char* end)
+{
+	while (p < end && p > begin && strchr("-/*\\", p[-1]))
+		++p;
+	return p;
+}
+
+std::vector<const char*> statement_splits(const char* begin, const char* end, thread_pool& pool,
+	std::size_t piece_bytes)
+{
+	const scan_kernels& kernels = select_scan_kernels();
+	piece_bytes = std::max<std::size_t>(piece_bytes, 1);
+
+	std::vector<const char*> bounds{ begin };
+	for (const char* p = begin; static_cast<std::size_t>(end - p) > piece_bytes;)
+	{
+		p = piece_boundary(begin, p + piece_bytes, end);
+		if (p < end)
+			bounds.push_back(p);
+	}
+	bounds.push_back(end);
+	std::size_t pieces = bounds.size() - 1;
+
+	// every piece from every state it might start in
+	std::vector<piece_scan> scans(pieces * split_states);
+	pool.parallel_for(pieces, [&](std::size_t i)
+	{
+		for (int s = 0; s < split_states; ++s)
+			scans[i * split_states + s] = scan_piece(kernels, bounds[i], bounds[i + 1], static_cast<split_state>(s));
+	});
+
+	std::vector<const char*> splits{ begin };
+	split_state s = in_code;
+	for (std::size_t i = 0; i < pieces; ++i)
+	{
+		const piece_scan& r = scans[i * split_states + s];
+		if (i > 0 && r.split && r.split < end)
+			splits.push_back(r.split);
+		s = r.end;
+	}
+	splits.push_back(end);
+	return splits;
+}
+
+std::size_t lex_parallel(const char* begin, const char* end, token_buffer& out, thread_pool& pool,
+	std::size_t piece_bytes, bool recover)
+{
+	std::vector<const char*> splits = statement_splits(begin, end, pool, piece_bytes);
+	std::size_t parts = splits.size() - 1;
+
+	// newlines per part, so an error in a part is located by its line in the script
+	std::vector<std::uint64_t> newlines(parts, 0);
+	std::vector<const char*> last_line(parts, nullptr);	// one past the part's last '\n'
+	pool.parallel_for(parts, [&](std::size_t i)
+	{
+		const char* lim = splits[i + 1];
+		for (const char* p = splits[i]; p < lim; ++p)
+		{
+			p = static_cast<const char*>(memchr(p, '\n', lim - p));
+			if (!p)
+				break;
+			++newlines[i];
+			last_line[i] = p + 1;
+		}
+	});
+	std::vector<std::uint64_t> lines_before(parts, 0), line_start(parts, 0);
+	for (std::size_t i = 1; i < parts; ++i)
+	{
+		lines_before[i] = lines_before[i - 1] + newlines[i - 1];
+		line_start[i] = last_line[i - 1] ? last_line[i - 1] - begin : line_start[i - 1];
+	}
+
+	std::vector<token_buffer> lexed(parts);
+	pool.parallel_for(parts, [&](std::size_t i)
+	{
+		Scanner scanner(llvm::make_unique<memory_source>(splits[i], splits[i + 1], splits[i] - begin,
+			lines_before[i], line_start[i]));
+		scanner.set_recover(recover);
+		lexed[i].fill_all(scanner);
+	});
+
+	// stitch: sizes first, then every part copies itself into place
+	std::vector<std::size_t> at(parts + 1, out.size()), text_at(parts + 1, out.text.size());
+	for (std::size_t i = 0; i < parts; ++i)
+	{
+		at[i + 1] = at[i] + lexed[i].size();
+		text_at[i + 1] = text_at[i] + lexed[i].text.size();
+	}
+	out.kinds.resize(at[parts]);
+	out.lengths.resize(at[parts]);
+	out.payload.resize(at[parts]);
+	out.offsets.resize(at[parts]);
+	out.text.resize(text_at[parts]);
+	pool.parallel_for(parts, [&](std::size_t i)
+	{
+		const token_buffer& part = lexed[i];
+		std::size_t n = part.size();
+		std::copy_n(part.kinds.data(), n, out.kinds.data() + at[i]);
+		std::copy_n(part.lengths.data(), n, out.lengths.data() + at[i]);
+		std::copy_n(part.payload.data(), n, out.payload.data() + at[i]);
+		std::copy_n(part.offsets.data(), n, out.offsets.data() + at[i]);
+		std::copy_n(part.text.data(), part.text.size(), &out.text[text_at[i]]);
+		std::int64_t shift = static_cast<std::int64_t>(text_at[i]);
+		for (std::size_t k = 0; k < n; ++k)
+			if (part.kinds[k] == literal_string || part.kinds[k] == lex_error)
+				out.payload[at[i] + k] += shift;
+	});
+	return at[parts] - at[0];
+}
@@ -17,446 +17,540 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include<exception>
 #include"llvmsql.h"
 #include"catalog.h"
+#include"scan_source.h"
 using namespace llvm;
 
 /// SQL begin
 
-std::map<table_col, SQLcol> name_entity_map;
+std::unordered_map<table_col, SQLcol> name_entity_map;
 
 /// SQL end
 
 using LR = std::vector<std::unique_ptr<ExprAST>> ;
 using LL = std::vector<std::unique_ptr<ExprAST>> ;
-token currtoken;
 
-void init_parser()
+void Parser::init(std::size_t from)
 {
-	currtoken = gettok();
+	pos = from;
+	if (scanner)
+	{
+		pos = 0;
+		own.clear();
+		own.push(scanner->gettok());
+	}
+	currtoken = tokens->at(pos);
 }
 
-
-bool iscompop(const int& i)
+// streaming: once its own buffer is used up it is cleared before the next token is pulled from the scanner
+void Parser::next()
 {
-	return i == eq_mark || i == gteq_mark || i == gt_mark || i == lteq_mark || i == lt_mark || i == ltgt_mark || i == noteq_mark;
+	++pos;
+	if (scanner && pos >= own.size())
+	{
+		own.clear();
+		pos = 0;
+		own.push(scanner->gettok());
+	}
+	currtoken = tokens->at(pos);
 }
 
-
-
-std::unique_ptr<ExprAST> ParseExprAST()
+token Parser::lookahead(std::size_t k)
 {
-	auto lhs = ParseExpAST();
-	std::unique_ptr<ExprAST> rhs = nullptr;
-	int op;
-	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
-	{
-		currtoken = gettok();
-	}
-	if (currtoken.token_kind == symbol &&
-		(currtoken.token_value.symbol_mark == and_mark ||
-			currtoken.token_value.symbol_mark == andand_mark ||
-			currtoken.token_value.symbol_mark == or_mark ||
-			currtoken.token_value.symbol_mark == oror_mark)
-		)
+	if (scanner)
 	{
-		op = currtoken.token_value.symbol_mark;
-		rhs = ParseExprAST();
-		return llvm::make_unique<ExprAST>(lhs, op, rhs);
+		while (own.size() <= pos + k && own.kinds.back() != eof)
+			own.push(scanner->gettok());
+		// the text pool may have moved
+		currtoken = tokens->at(pos);
 	}
-	else
-		return llvm::make_unique<ExprAST>(lhs);
-		
-	
+	return tokens->at(pos + k);
 }
 
-std::unique_ptr<ExpAST> ParseExpAST()
+
+// operator table, MySQL precedence from loosest to tightest; each level is left associative
+enum op_prec : std::uint8_t
 {
-	std::unique_ptr<ExprAST> expr = nullptr;
-	std::unique_ptr<BooleanPrimaryAST> bp = nullptr;
-	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
-	{
-		currtoken = gettok();
-	}
-	if (currtoken.token_kind == symbol &&
-		(currtoken.token_value.symbol_mark == tok_NOT || currtoken.token_value.symbol_mark == not_mark))
-	{
-		currtoken = gettok();	// consume ! or NOT
-		expr = ParseExprAST();
-	}
-	else
-	{
-		bp = ParseBPAST();
-	}
-	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
+	prec_none,
+	prec_or,		// OR ||
+	prec_xor,		// XOR
+	prec_and,		// AND &&
+	prec_not,		// NOT (prefix)
+	prec_compare,	// = <=> >= > <= < <> != IS IN LIKE REGEXP, and NOT before IN LIKE REGEXP
+	prec_bitor,		// |
+	prec_bitand,	// &
+	prec_shift,		// << >>
+	prec_add,		// + -
+	prec_mul,		// * / % DIV MOD
+	prec_bitxor,	// ^
+	prec_unary		// - + ~ ! (prefix)
+};
+
+struct infix_op
+{
+	int mark;
+	op_prec prec;
+};
+
+static const infix_op infix_ops[] =
+{
+	{ tok_OR, prec_or }, { oror_mark, prec_or },
+	{ tok_XOR, prec_xor },
+	{ tok_AND, prec_and }, { andand_mark, prec_and },
+	{ eq_mark, prec_compare }, { lteqgt_mark, prec_compare }, { gteq_mark, prec_compare },
+	{ gt_mark, prec_compare }, { lteq_mark, prec_compare }, { lt_mark, prec_compare },
+	{ ltgt_mark, prec_compare }, { noteq_mark, prec_compare },
+	{ tok_IS, prec_compare }, { tok_IN, prec_compare }, { tok_LIKE, prec_compare },
+	{ tok_REGEXP, prec_compare }, { tok_NOT, prec_compare },
+	{ or_mark, prec_bitor },
+	{ and_mark, prec_bitand },
+	{ left_shift_mark, prec_shift }, { right_shift_mark, prec_shift },
+	{ plus_mark, prec_add }, { minus_mark, prec_add },
+	{ mult_mark, prec_mul }, { div_mark, prec_mul }, { mod_mark, prec_mul },
+	{ tok_DIV, prec_mul }, { tok_MOD, prec_mul },
+	{ hat_mark, prec_bitxor },
+};
+
+// symbol_mark runs from the last keyword to the last punctuation mark
+constexpr int lowest_mark = tok_ZEROFILL;
+constexpr int highest_mark = backquote_mark;
+
+static op_prec infix_precedence(int mark)
+{
+	static const std::vector<op_prec> table = []
 	{
-		currtoken = gettok();
-	}
-	return llvm::make_unique<ExpAST>(expr, bp);
+		std::vector<op_prec> t(highest_mark - lowest_mark + 1, prec_none);
+		for (const infix_op& op : infix_ops)
+			t[op.mark - lowest_mark] = op.prec;
+		return t;
+	}();
+	return table[mark - lowest_mark];
 }
 
-std::unique_ptr<BooleanPrimaryAST> ParseBPAST()
+static bool is_comparison(int mark)
 {
-	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
-	{
-		currtoken = gettok();
-	}
-	auto p = ParsePredicateAST();
-	if (currtoken.token_kind == symbol &&
-		(currtoken.token_value.symbol_mark == tok_IS || iscompop(currtoken.token_value.symbol_mark))
-		)
-	{
-		if (currtoken.token_value.symbol_mark == tok_IS)
-		{
-			currtoken = gettok();	// consume IS
-			std::unique_ptr<bool> flag = nullptr;
-			if (currtoken.token_kind == symbol &&currtoken.token_value.symbol_mark == tok_NOT)
-			{
-				flag = llvm::make_unique<bool>(false);
-				currtoken = gettok();	// consume NOT
-				currtoken = gettok();	// consume NULL
-				return  llvm::make_unique<BooleanPrimaryAST>(llvm::make_unique<BooleanPrimaryAST>(p), flag);
-			}
-			else if (currtoken.token_kind == symbol &&currtoken.token_value.symbol_mark == tok_NULL)
-			{
-				flag = llvm::make_unique<bool>(true);
-				currtoken = gettok();	// consume NULL
-				return  llvm::make_unique<BooleanPrimaryAST>(llvm::make_unique<BooleanPrimaryAST>(p), flag);
-			}
-			else
-			{
-				throw std::runtime_error("expect IS [NOT] NULL \n");
-			}
-		}
-		else
-		{
-			auto op = llvm::make_unique<int>(currtoken.token_value.symbol_mark);
-			currtoken = gettok();	// consume op
-			if ((currtoken.token_kind == symbol &&
-				(currtoken.token_value.symbol_mark == tok_ALL || currtoken.token_value.symbol_mark == tok_ANY)
-				))
-			{
-				currtoken = gettok();	// consume all/any
-				currtoken = gettok();	// consume '('
-				auto sub = ParseSubqueryAST();
-				auto bp = llvm::make_unique<BooleanPrimaryAST>(p);
-				return llvm::make_unique<BooleanPrimaryAST>(bp, sub, op);
-			}
-			else
-			{
-				auto bp = llvm::make_unique<BooleanPrimaryAST>(p);
-				auto p2= ParsePredicateAST();
-				return llvm::make_unique<BooleanPrimaryAST>(bp, p2, op);
-			}
-		}
-		
-	}
-	else
-	{
-		while (currtoken.token_kind == blank || currtoken.token_kind == comment)
-		{
-			currtoken = gettok();
-		}
-		return llvm::make_unique<BooleanPrimaryAST>(p);
-	}
+	return mark > 0 && infix_precedence(mark) == prec_compare;
 }
 
-std::unique_ptr<PredicateAST> ParsePredicateAST()
+// precedence climbing with explicit stacks: operators at least as tight as
+// the incoming one are reduced first (left associative), '(' and prefix
+// operators wait on op_stack, so neither a 100k-term AND nor deep nesting
+// recurses.  Only subqueries, call arguments and IN lists call back in.
+std::unique_ptr<ExprAST> Parser::ParseExprAST()
 {
-	auto bitexpr = ParseBitExprAST();
-	if (currtoken.token_kind == symbol &&
-		(currtoken.token_value.symbol_mark == tok_NOT ||
-			currtoken.token_value.symbol_mark == tok_REGEXP || currtoken.token_value.symbol_mark == tok_IN))
+	std::size_t operand_base = operand_stack.size(), op_base = op_stack.size();
+	try
 	{
-		if (currtoken.token_kind == symbol &&currtoken.token_value.symbol_mark == tok_NOT)
+		while (true)
 		{
-			currtoken = gettok();	//consum NOT
-			auto flag = llvm::make_unique<bool>(false);
-			if (currtoken.token_kind == symbol &&currtoken.token_value.symbol_mark == tok_REGEXP)
+			// prefix operators and '(' wait for the operand
+			while (true)
 			{
-				currtoken = gettok();	//consume REGEXP
-				auto rhs = ParseBitExprAST();
-				return llvm::make_unique<PredicateAST>(bitexpr, rhs, flag);
+				if (is_symbol(tok_NOT))
+					op_stack.push_back({ tok_NOT, prec_not, true, false });
+				else if (is_symbol(not_mark) || is_symbol(minus_mark) || is_symbol(plus_mark) || is_symbol(tilde_mark))
+					op_stack.push_back({ currtoken.symbol_mark, prec_unary, true, false });
+				else if (is_symbol(left_bracket_mark) && !(lookahead(1).token_kind == symbol && lookahead(1).symbol_mark == tok_SELECT))
+					op_stack.push_back({ left_bracket_mark, prec_none, false, false });
+				else
+					break;
+				next();
 			}
-			else if (currtoken.token_kind == symbol &&currtoken.token_value.symbol_mark == tok_IN)
+			operand_stack.push_back(ParseSEAST());
+
+			// postfix operators and ')' apply here; an infix one goes back for its right operand
+			bool infix = false;
+			while (!infix && currtoken.token_kind == symbol)
 			{
-				currtoken = gettok();	//consume IN
-				if (currtoken.token_kind == symbol &&currtoken.token_value.symbol_mark == left_bracket_mark)
+				int op = currtoken.symbol_mark;
+				if (op == right_bracket_mark)
 				{
-					currtoken = gettok();	//consume '('
+					while (op_stack.size() > op_base && op_stack.back().op != left_bracket_mark)
+						reduce();
+					if (op_stack.size() == op_base)
+						break;	// the caller's ')'
+					op_stack.pop_back();
+					next();	// consume ')'
+					continue;
 				}
-				else
+				op_prec prec = infix_precedence(op);
+				if (prec == prec_none)
+					break;
+				while (op_stack.size() > op_base && op_stack.back().op != left_bracket_mark && op_stack.back().prec >= prec)
+					reduce();
+				next();	// consume op
+				if (prec != prec_compare)
 				{
-					throw std::runtime_error("expect '(' \n");
+					op_stack.push_back({ op, prec, false, false });
+					infix = true;
 				}
-				if (currtoken.token_kind == symbol &&currtoken.token_value.symbol_mark == tok_SELECT)
+				else if (op == tok_IS)
 				{
-					auto sub = ParseSubqueryAST();
-					return llvm::make_unique<PredicateAST>(bitexpr, sub, flag);
+					bool negated = is_symbol(tok_NOT);
+					if (negated)
+						next();	// consume NOT
+					expect(tok_NULL, "expect IS [NOT] NULL \n");
+					operand_stack.back() = make<IsNullAST>(std::move(operand_stack.back()), negated);
 				}
-				else
+				else if (is_comparison(op))
 				{
-					std::vector<std::unique_ptr<ExprAST>> exprs;
-					auto expr = ParseExprAST();
-					exprs.push_back(std::move(expr));
-					while (currtoken.token_kind == symbol&&currtoken.token_value.symbol_mark == comma_mark)
+					if (is_symbol(tok_ALL) || is_symbol(tok_ANY) || is_symbol(tok_SOME))
 					{
-						currtoken = gettok();	//consume ','
-						expr = ParseExprAST();
-						exprs.push_back(std::move(expr));
+						int quantifier = currtoken.symbol_mark == tok_ALL ? tok_ALL : tok_ANY;
+						next();	// consume ALL / ANY / SOME
+						expect(left_bracket_mark, "expect '(' \n");
+						auto sub = ParseSubqueryAST();
+						expect(right_bracket_mark, "expect ')' \n");
+						operand_stack.back() = make<QuantifiedExprAST>(op, quantifier, std::move(operand_stack.back()), std::move(sub));
 					}
-					if (currtoken.token_kind == symbol&&currtoken.token_value.symbol_mark == right_bracket_mark)
+					else
 					{
-						currtoken = gettok();	//consume ')'
-						return llvm::make_unique<PredicateAST>(bitexpr, exprs, flag);
+						op_stack.push_back({ op, prec, false, false });
+						infix = true;
 					}
+				}
+				else
+				{
+					// [NOT] IN, [NOT] LIKE, [NOT] REGEXP
+					bool negated = op == tok_NOT;
+					if (negated)
+					{
+						if (!(is_symbol(tok_IN) || is_symbol(tok_LIKE) || is_symbol(tok_REGEXP)))
+							fail("expect IN, LIKE or REGEXP after NOT \n");
+						op = currtoken.symbol_mark;
+						next();
+					}
+					if (op == tok_IN)
+						operand_stack.back() = ParseInAST(std::move(operand_stack.back()), negated);
 					else
 					{
-						throw std::runtime_error("expect ')' \n");
+						op_stack.push_back({ op, prec, false, negated });
+						infix = true;
 					}
-
 				}
-				
 			}
+			if (!infix)
+				break;
+		}
+		while (op_stack.size() > op_base)
+		{
+			if (op_stack.back().op == left_bracket_mark)
+				fail("expected ')' ");
+			reduce();
 		}
+		auto e = std::move(operand_stack.back());
+		operand_stack.pop_back();
+		return e;
 	}
-	else
+	catch (...)
 	{
-		return llvm::make_unique<PredicateAST>(bitexpr);
+		operand_stack.resize(operand_base);
+		op_stack.resize(op_base);
+		throw;
 	}
 }
 
-std::unique_ptr<BitExprAST> ParseBitExprAST()
+// apply the operator on top of op_stack to the operands on top of operand_stack
+void Parser::reduce()
 {
-	auto bitexp = ParseBitExpAST();
-	if (currtoken.token_kind == symbol &&
-		(currtoken.token_value.symbol_mark == plus_mark || currtoken.token_value.symbol_mark == minus_mark))
+	pending_op p = op_stack.back();
+	op_stack.pop_back();
+	auto rhs = std::move(operand_stack.back());
+	operand_stack.pop_back();
+	if (p.prefix)
 	{
-		auto op = llvm::make_unique<int>(currtoken.token_value.symbol_mark);
-		currtoken = gettok();	// consume '-' or  '+ '
-		auto bitexpr = ParseBitExprAST();
-		return llvm::make_unique<BitExprAST>(bitexp, op, bitexpr);
+		operand_stack.push_back(make<UnaryExprAST>(p.op, std::move(rhs)));
+		return;
 	}
-	else
+	std::unique_ptr<ExprAST>& lhs = operand_stack.back();
+	if (p.prec == prec_and || p.prec == prec_or)
 	{
-		return llvm::make_unique<BitExprAST>(bitexp);
+		// a AND b AND c grows one node
+		int op = p.prec == prec_and ? tok_AND : tok_OR;
+		if (lhs->kind == logical_expr && static_cast<LogicalExprAST&>(*lhs).op == op)
+			static_cast<LogicalExprAST&>(*lhs).operands.push_back(std::move(rhs));
+		else
+			lhs = make<LogicalExprAST>(op, std::move(lhs), std::move(rhs));
+		return;
 	}
+	lhs = make<BinaryExprAST>(p.op, std::move(lhs), std::move(rhs));
+	if (p.negated)
+		lhs = make<UnaryExprAST>(tok_NOT, std::move(lhs));
 }
 
-std::unique_ptr<BitExpAST> ParseBitExpAST()
+// what ParseExprAST builds without recursing is freed without recursing too:
+// an operator node moves its operands to a worklist before it goes, so a
+// 100k-level chain needs no more stack to tear down than one node
+static bool is_operator(const ExprAST* e)
 {
-	auto bitex = ParseBitExAST();
-	if (currtoken.token_kind == symbol &&
-		(currtoken.token_value.symbol_mark == mult_mark || currtoken.token_value.symbol_mark == div_mark
-			|| currtoken.token_value.symbol_mark == mod_mark))
+	return e && (e->kind == unary_expr || e->kind == binary_expr || e->kind == logical_expr);
+}
+
+static void take_operands(ExprAST& e, llvm::SmallVectorImpl<std::unique_ptr<ExprAST>>& work)
+{
+	if (auto u = llvm::dyn_cast<UnaryExprAST>(&e))
+		work.push_back(std::move(u->operand));
+	else if (auto b = llvm::dyn_cast<BinaryExprAST>(&e))
 	{
-		auto op = llvm::make_unique<int>(currtoken.token_value.symbol_mark);
-		currtoken = gettok();	// consume '*' or  '/ ' or '%'
-		auto bitexp = ParseBitExpAST();
-		return llvm::make_unique<BitExpAST>(bitex, op, bitexp);
+		work.push_back(std::move(b->lhs));
+		work.push_back(std::move(b->rhs));
 	}
-	else
+	else if (auto l = llvm::dyn_cast<LogicalExprAST>(&e))
 	{
-		return llvm::make_unique<BitExpAST>(bitex);
+		for (auto& o : l->operands)
+			work.push_back(std::move(o));
+		l->operands.clear();
 	}
 }
 
-std::unique_ptr<BitExAST> ParseBitExAST()
+static void release_operands(ExprAST& e)
 {
-	if (currtoken.token_kind == symbol &&
-		(currtoken.token_value.symbol_mark == plus_mark || currtoken.token_value.symbol_mark == minus_mark))
+	// nothing but leaves under it: their own destructors are enough
+	llvm::SmallVector<std::unique_ptr<ExprAST>, 16> work;
+	take_operands(e, work);
+	if (std::none_of(work.begin(), work.end(), [](const std::unique_ptr<ExprAST>& o) { return is_operator(o.get()); }))
+		return;
+	while (!work.empty())
 	{
-		auto mark = llvm::make_unique<int>(currtoken.token_value.symbol_mark);
-		currtoken = gettok();	//consume mark
-		auto bitex = ParseBitExAST();
-		return llvm::make_unique<BitExAST>(mark, bitex);
-	}
-	else
-	{
-		auto SE = ParseSEAST();
-		return llvm::make_unique<BitExAST>(SE);
+		std::unique_ptr<ExprAST> o = std::move(work.back());
+		work.pop_back();
+		if (is_operator(o.get()))
+			take_operands(*o, work);
 	}
 }
 
-std::unique_ptr<SimpleExprAST> ParseSEAST()
+UnaryExprAST::~UnaryExprAST() { release_operands(*this); }
+BinaryExprAST::~BinaryExprAST() { release_operands(*this); }
+LogicalExprAST::~LogicalExprAST() { release_operands(*this); }
+
+// lhs [NOT] IN, at the '('
+std::unique_ptr<ExprAST> Parser::ParseInAST(std::unique_ptr<ExprAST> lhs, bool negated)
 {
-	if (currtoken.token_kind == literal_double || currtoken.token_kind == literal_string
-		|| currtoken.token_kind == literal_int)
+	expect(left_bracket_mark, "expect '(' \n");
+	if (is_symbol(tok_SELECT))
 	{
-		auto lit = ParseLiteralAST();
-		return llvm::make_unique<SimpleExprAST>(lit);
+		auto sub = ParseSubqueryAST();
+		expect(right_bracket_mark, "expect ')' \n");
+		return make<InSubqueryAST>(std::move(lhs), std::move(sub), negated);
 	}
-	else if (currtoken.token_kind == id)
+
+	auto in = make<InListAST>(std::move(lhs), negated);
+	in_ints.clear();
+	in_doubles.clear();
+	in_strings.clear();
+	bool values = true;		// every item so far is a literal of in->values_kind
+	std::size_t count = 0;
+	while (true)
 	{
-		auto idstr = ParseIdAST();
-		LR lr;
-		lr.push_back(std::move(idstr));
-		if (currtoken.token_kind == currtoken.token_kind == symbol &&currtoken.token_value.symbol_mark == dot_mark)
+		// 5, -5, 2.5, -2.5 or 'x', followed by ',' or ')'
+		bool minus = is_symbol(minus_mark);
+		token after = lookahead(minus ? 2 : 1);
+		token t = minus ? lookahead(1) : currtoken;
+		int kind = -1;
+		if (t.token_kind == literal_int || t.token_kind == literal_bigint)
+			kind = int_expr;
+		else if (t.token_kind == literal_double)
+			kind = double_expr;
+		else if (t.token_kind == literal_string && !minus)
+			kind = string_expr;
+		bool alone = after.token_kind == symbol &&
+			(after.symbol_mark == comma_mark || after.symbol_mark == right_bracket_mark);
+
+		if (values && kind >= 0 && alone && (count == 0 || kind == in->values_kind))
 		{
-			;
+			in->values_kind = static_cast<expr_kind>(kind);
+			if (kind == int_expr)
+				in_ints.push_back(minus ? static_cast<std::int64_t>(0 - static_cast<std::uint64_t>(t.int_literal)) : t.int_literal);
+			else if (kind == double_expr)
+				in_doubles.push_back(minus ? -t.double_literal : t.double_literal);
+			else
+				in_strings.push_back(nodes().copy(t.str()));
+			if (minus)
+				next();
+			next();
 		}
-		else if ( currtoken.token_kind == symbol &&currtoken.token_value.symbol_mark == left_bracket_mark)
+		else
 		{
-			currtoken = gettok();	//s=consume '('
-			if (currtoken.token_kind == symbol &&currtoken.token_value.symbol_mark == dot_mark)
+			if (values)
 			{
-				currtoken = gettok();	//s=consume '.'
-				auto colname = ParseIdAST();
-				auto tablename = std::move((lr[0])->lhs->bp->p->bitexpr->bitexp->bitex->SE->lit->stringvalue->value);
-				auto tablecol = llvm::make_unique<TablecolAST>(tablename, colname);
-				return llvm::make_unique<SimpleExprAST>(tablecol);
-			}
-			else
-			{
-				auto call = ParseCallAST(std::move((lr[0])->lhs->bp->p->bitexpr->bitexp->bitex->SE->lit->stringvalue->value));
-				return llvm::make_unique<SimpleExprAST>(call);
+				// not a plain value list after all
+				values = false;
+				for (std::int64_t v : in_ints)
+					in->list.push_back(make<IntLiteralAST>(v));
+				for (double v : in_doubles)
+					in->list.push_back(make<DoubleLiteralAST>(v));
+				for (llvm::StringRef v : in_strings)
+					in->list.push_back(make<StringLiteralAST>(v));
 			}
+			in->list.push_back(ParseExprAST());
 		}
-		else
+		++count;
+		if (!is_symbol(comma_mark))
+			break;
+		next();	// consume ','
+	}
+	expect(right_bracket_mark, "expect ')' \n");
+	if (values)
+	{
+		in->ints = nodes().copy(in_ints.data(), in_ints.size());
+		in->doubles = nodes().copy(in_doubles.data(), in_doubles.size());
+		in->strings = nodes().copy(in_strings.data(), in_strings.size());
+	}
+	return in;
+}
+
+std::unique_ptr<ExprAST> Parser::ParseSEAST()
+{
+	if (currtoken.token_kind == literal_double || currtoken.token_kind == literal_string
+		|| currtoken.token_kind == literal_int || currtoken.token_kind == literal_bigint)
+	{
+		return ParseLiteralAST();
+	}
+	else if (currtoken.token_kind == id)
+	{
+		auto next_token = lookahead(1);
+		if (next_token.token_kind == symbol && next_token.symbol_mark == dot_mark)
+		{
+			return ParseTablecolAST();
+		}
+		auto name = ParseIdAST();
+		if (next_token.token_kind == symbol && next_token.symbol_mark == left_bracket_mark)
 		{
-			auto str = std::move((lr[0])->lhs->bp->p->bitexpr->bitexp->bitex->SE->lit->stringvalue->value);
-			auto idast = llvm::make_unique<IdAST>(str);
-			return llvm::make_unique<SimpleExprAST>(idast);
+			next();	// consume '('
+			return ParseCallAST(name->id);
 		}
+		return name;
 	}
 	else if (currtoken.token_kind == symbol &&
-		(currtoken.token_value.symbol_mark == left_bracket_mark || currtoken.token_value.symbol_mark == tok_EXISTS))
+		currtoken.symbol_mark == left_bracket_mark)
 	{
-		
-
+		return ParseParenExprAST();
+	}
+	else if (currtoken.token_kind == symbol && currtoken.symbol_mark == tok_EXISTS)
+	{
+		return ParseExistsSubqueryAST();
+	}
+	else if (is_symbol(qusetion_mark))
+	{
+		next();	// consume '?'
+		return make<ParamAST>(params++);
 	}
 	else
 	{
-		throw std::runtime_error("expect simple expression");
+		fail("expect simple expression");
 	}
 }
 
-class SimpleExprAST :public BitExAST
-{
-public:
-	std::unique_ptr<IdAST> id = nullptr;
-	std::unique_ptr<CallAST> call = nullptr;
-	std::unique_ptr<TablecolAST> tablecol = nullptr;
-	std::unique_ptr<ExprAST> expr = nullptr;
-	std::unique_ptr<SubqueryAST> sub = nullptr;
-	std::unique_ptr<ExistsSubqueryAST> exists = nullptr;
-	std::unique_ptr<LiteralAST> lit = nullptr;
-
-	SimpleExprAST() = default;
-	SimpleExprAST(std::unique_ptr<IdAST> id) :id(std::move(id)) {}
-	SimpleExprAST(std::unique_ptr<CallAST> call) :call(std::move(call)) {}
-	SimpleExprAST(std::unique_ptr<TablecolAST> tablecol) :tablecol(std::move(tablecol)) {}
-	SimpleExprAST(std::unique_ptr<ExprAST> expr) :expr(std::move(expr)) {}
-	SimpleExprAST(std::unique_ptr<SubqueryAST> sub) :sub(std::move(sub)) {}
-	SimpleExprAST(std::unique_ptr<ExistsSubqueryAST> exists) :exists(std::move(exists)) {}
-	SimpleExprAST(std::unique_ptr<LiteralAST> lit) :lit(std::move(lit)) {}
-};
-
-
-
-std::unique_ptr<StringLiteralAST> ParseStringLiteralAST()
+std::unique_ptr<StringLiteralAST> Parser::ParseStringLiteralAST()
 {
 	while (currtoken.token_kind == blank|| currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
 	if (currtoken.token_kind != literal_string)
 	{
-		throw std::runtime_error("expect string literal\n");
+		fail("expect string literal\n");
 	}
-	std::string temps = currtoken.token_value.string_literal;
-	currtoken=gettok(); // consume 1 string token
+	std::string temps = currtoken.str().str();
+	next(); // consume 1 string token
 				   // wait,  this string may be concat
 	while (currtoken.token_kind == literal_string)
 	{
-		temps += currtoken.token_value.string_literal;
-		currtoken=gettok(); // consume 1 string token
+		temps.append(currtoken.text, currtoken.length);
+		next(); // consume 1 string token
 	}
-	auto result = llvm::make_unique<StringLiteralAST>(temps);
+	auto result = make<StringLiteralAST>(nodes().copy(temps));
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
-	return std::move(result);
+	return result;
 }
 
-std::unique_ptr<IntLiteralAST> ParseIntLiteralAST()
+std::unique_ptr<IntLiteralAST> Parser::ParseIntLiteralAST()
 {
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
-	if (currtoken.token_kind != literal_int)
+	if (currtoken.token_kind != literal_int && currtoken.token_kind != literal_bigint)
 	{
-		throw std::runtime_error("expect int literal\n");
+		fail("expect int literal\n");
 	}
-	auto result = llvm::make_unique<IntLiteralAST>(currtoken.token_value.int_literal);
-	currtoken = gettok(); // consume 1 int token
+	auto result = make<IntLiteralAST>(currtoken.int_literal);
+	next(); // consume 1 int token
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
-	return std::move(result);
+	return result;
 }
 
-std::unique_ptr<DoubleLiteralAST> ParseDoubleLiteralAST()
+std::unique_ptr<DoubleLiteralAST> Parser::ParseDoubleLiteralAST()
 {
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
 	if (currtoken.token_kind != literal_double)
 	{
-		throw std::runtime_error("expect double literal\n");
+		fail("expect double literal\n");
 	}
-	auto result = llvm::make_unique<DoubleLiteralAST>(currtoken.token_value.double_literal);
-	currtoken = gettok(); // consume 1 double token
+	auto result = make<DoubleLiteralAST>(currtoken.double_literal);
+	next(); // consume 1 double token
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
-	return std::move(result);
+	return result;
 }
 
-std::unique_ptr<ParenExprAST> ParseParenExprAST()
+// (expr) or (SELECT ...); the parentheses leave no node behind
+std::unique_ptr<ExprAST> Parser::ParseParenExprAST()
 {
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
-	if (currtoken.token_kind == symbol&&currtoken.token_value.symbol_mark == left_bracket_mark)
+	if (currtoken.token_kind == symbol&&currtoken.symbol_mark == left_bracket_mark)
 	{
-		currtoken = gettok();
-		auto e = ParseExprAST();
-		if (!(currtoken.token_kind == symbol&&currtoken.token_value.symbol_mark == right_bracket_mark))
-			throw std::runtime_error("expected ')' ");
+		next();
+		std::unique_ptr<ExprAST> e;
+		if (is_symbol(tok_SELECT))
+			e = ParseSubqueryAST();
 		else
-			return llvm::make_unique<ParenExprAST>(e);
+			e = ParseExprAST();
+		if (!(currtoken.token_kind == symbol&&currtoken.symbol_mark == right_bracket_mark))
+			fail("expected ')' ");
+		next();	// consume ')'
+		return e;
 	}
-	throw std::runtime_error("expected '(' ");
+	fail("expected '(' ");
 }
 
-std::unique_ptr<LiteralAST> ParseLiteralAST()
+std::unique_ptr<ExprAST> Parser::ParseLiteralAST()
 {
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
 	if (currtoken.token_kind == literal_double)
 	{
 		while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 		{
-			currtoken = gettok();
+			next();
 		}
 		return ParseDoubleLiteralAST();
 	}
-	if (currtoken.token_kind == literal_int)
+	if (currtoken.token_kind == literal_int || currtoken.token_kind == literal_bigint)
 	{
 		while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 		{
-			currtoken = gettok();
+			next();
 		}
 		return ParseIntLiteralAST();
 	}
@@ -464,244 +558,769 @@ std::unique_ptr<LiteralAST> ParseLiteralAST()
 	{
 		while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 		{
-			currtoken = gettok();
+			next();
 		}
 		return ParseStringLiteralAST();
 	}
 	else
-		throw std::runtime_error("expect literal(int,float or string\n)");
+		fail("expect literal (int, float or string)");
 }
 
-std::unique_ptr<IdAST> ParseIdAST()
+std::unique_ptr<IdAST> Parser::ParseIdAST()
 {
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
 	if (currtoken.token_kind != id)
 	{
-		throw std::runtime_error("expect identifier \n)");
+		fail("expect identifier");
 	}
-	auto result = llvm::make_unique<IdAST>(currtoken.token_value.IdentifierStr);
-	currtoken = gettok(); // consume 1 id
+	auto result = make<IdAST>(currtoken.name);
+	next(); // consume 1 id
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
-	return std::move(result);
+	return result;
 };
 
-std::unique_ptr<CallAST> ParseCallAST()
+std::unique_ptr<CallAST> Parser::ParseCallAST()
 {
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
 	decltype(ParseIdAST()) x = nullptr;
 	try
 	{
-		ParseIdAST();
-	}
-	catch (std::runtime_error(s))
-	{
-		throw std::runtime_error(s);
-	}
-	std::unique_ptr<std::string> callee = std::move(x->id);
-	if (!(currtoken.token_kind == symbol && currtoken.token_value.symbol_mark != left_bracket_mark))
-	{
-		throw std::runtime_error("expect '(' \n");
+		x = ParseIdAST();
 	}
-	std::vector<std::unique_ptr<ExprAST>> args;
-	args.push_back(ParseExprAST());
-	while (currtoken.token_kind == symbol && currtoken.token_value.symbol_mark != comma_mark)
+	catch (std::runtime_error&)
 	{
-		currtoken = gettok();    // consume 1 comma token
-		args.push_back(ParseExprAST());
+		throw;
 	}
-	if (currtoken.token_kind == symbol && currtoken.token_value.symbol_mark != right_bracket_mark)
+	atom callee = x->id;
+	if (!(currtoken.token_kind == symbol && currtoken.symbol_mark == left_bracket_mark))
 	{
-		return llvm::make_unique<CallAST>(callee, args);
+		fail("expect '(' \n");
 	}
-	else
-		throw std::runtime_error("expect ')'");
+	next();    // consume '('
+	return ParseCallAST(callee);
 
 }
 
-std::unique_ptr<CallAST> ParseCallAST(std::unique_ptr<std::string> callee)
+std::unique_ptr<CallAST> Parser::ParseCallAST(atom callee)
 {
 	std::vector<std::unique_ptr<ExprAST>> args;
-	args.push_back(ParseExprAST());
-	while (currtoken.token_kind == symbol && currtoken.token_value.symbol_mark != comma_mark)
+	if (!(currtoken.token_kind == symbol && currtoken.symbol_mark == right_bracket_mark))
 	{
-		currtoken = gettok();    // consume 1 comma token
 		args.push_back(ParseExprAST());
+		while (currtoken.token_kind == symbol && currtoken.symbol_mark == comma_mark)
+		{
+			next();    // consume 1 comma token
+			args.push_back(ParseExprAST());
+		}
 	}
-	if (currtoken.token_kind == symbol && currtoken.token_value.symbol_mark != right_bracket_mark)
+	if (currtoken.token_kind == symbol && currtoken.symbol_mark == right_bracket_mark)
 	{
-		return llvm::make_unique<CallAST>(callee, args);
+		next();    // consume ')'
+		return make<CallAST>(callee, std::move(args));
 	}
 	else
-		throw std::runtime_error("expect ')'");
+		fail("expect ')'");
 }
 
-std::unique_ptr< ExistsSubqueryAST> ParseExistsSubqueryAST()
+std::unique_ptr< ExistsSubqueryAST> Parser::ParseExistsSubqueryAST()
 {
-	currtoken = gettok();  // consume 'EXISTS' reserved word
-	currtoken = gettok();  // consume '(' reserved word
+	next();  // consume 'EXISTS' reserved word
+	next();  // consume '(' reserved word
 	auto subquery = ParseSubqueryAST();
-	currtoken = gettok();  // consume ')' reserved word
-	return llvm::make_unique<ExistsSubqueryAST>(subquery);
+	next();  // consume ')' reserved word
+	return make<ExistsSubqueryAST>(std::move(subquery));
 };
 
-std::unique_ptr<SubqueryAST> ParseSubqueryAST()
+std::unique_ptr<SubqueryAST> Parser::ParseSubqueryAST()
 {
-	currtoken = gettok();    // consume 'SELECT' reserved word
-	bool distinct_flag, from_flag, where_flag, having_flag, group_flag, order_flag;
-	bool group_ASC, order_ASC;
-	LR lr;
+	next();    // consume 'SELECT' reserved word
+	bool distinct_flag = false, from_flag = false, where_flag = false, having_flag = false, group_flag = false, order_flag = false;
+	bool group_ASC = true, order_ASC = true;
+	if (is_symbol(tok_DISTINCT))
+	{
+		distinct_flag = true;
+		next();
+	}
+	std::vector<std::unique_ptr<SelectExprAST>> exprs;
+	exprs.push_back(ParseSelectExprAST());
+	while (is_symbol(comma_mark))
+	{
+		next();	// consume ','
+		exprs.push_back(ParseSelectExprAST());
+	}
+	std::unique_ptr<TableRefsAST> tbrefs = nullptr;
+	if (is_symbol(tok_FROM))
+	{
+		from_flag = true;
+		next();
+		tbrefs = ParseTableRefsAST();
+	}
+	std::unique_ptr<ExprAST> wherecond = nullptr;
+	if (is_symbol(tok_WHERE))
+	{
+		where_flag = true;
+		next();
+		wherecond = ParseExprAST();
+	}
+	std::vector<table_col> groupby_col_name, orderby_col_name;
+	if (is_symbol(tok_GROUP))
+	{
+		group_flag = true;
+		next();
+		expect(tok_BY, "expect BY after GROUP \n");
+		do
+		{
+			if (!groupby_col_name.empty())
+				next();	// consume ','
+			groupby_col_name.push_back(ParseColumnName());
+			if (is_symbol(tok_ASC) || is_symbol(tok_DESC))
+			{
+				group_ASC = is_symbol(tok_ASC);
+				next();
+			}
+		} while (is_symbol(comma_mark));
+	}
+	std::unique_ptr<ExprAST> havingcond = nullptr;
+	if (is_symbol(tok_HAVING))
+	{
+		having_flag = true;
+		next();
+		havingcond = ParseExprAST();
+	}
+	if (is_symbol(tok_ORDER))
+	{
+		order_flag = true;
+		next();
+		expect(tok_BY, "expect BY after ORDER \n");
+		do
+		{
+			if (!orderby_col_name.empty())
+				next();	// consume ','
+			orderby_col_name.push_back(ParseColumnName());
+			if (is_symbol(tok_ASC) || is_symbol(tok_DESC))
+			{
+				order_ASC = is_symbol(tok_ASC);
+				next();
+			}
+		} while (is_symbol(comma_mark));
+	}
+	return make<SubqueryAST>(distinct_flag, std::move(exprs),
+		from_flag, std::move(tbrefs),
+		where_flag, std::move(wherecond),
+		having_flag, std::move(havingcond),
+		group_flag, group_ASC, std::move(groupby_col_name),
+		order_flag, order_ASC, std::move(orderby_col_name));
 }
 
-std::unique_ptr<ColdefAST> ParseColdefAST()
+std::unique_ptr<ColdefAST> Parser::ParseColdefAST()
 {
-	auto colname = std::move(ParseIdAST()->id);
-	if (currtoken.token_kind == symbol&&currtoken.token_value.symbol_mark == tok_INT)
+	auto colname = ParseIdAST()->id;
+	if (currtoken.token_kind == symbol&&currtoken.symbol_mark == tok_INT)
 	{
 		while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 		{
-			currtoken = gettok();
+			next();
 		}
-		currtoken = gettok();    // consume `INT`
-		return llvm::make_unique<ColdefAST>(colname, literal_int, true, false, false);
+		next();    // consume `INT`
+		return make<ColdefAST>(colname, literal_int, true, false, false);
 	}
 	if (currtoken.token_kind == symbol &&
-		(currtoken.token_value.symbol_mark == tok_FLOAT || currtoken.token_value.symbol_mark == tok_DOUBLE))
+		(currtoken.symbol_mark == tok_FLOAT || currtoken.symbol_mark == tok_DOUBLE))
 	{
 		while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 		{
-			currtoken = gettok();
+			next();
 		}
-		currtoken = gettok();    // consume `DOUBLE`
-		return llvm::make_unique<ColdefAST>(colname, literal_double, true, false, false);
+		next();    // consume `DOUBLE`
+		return make<ColdefAST>(colname, literal_double, true, false, false);
 	}
-	if (currtoken.token_kind == symbol&&currtoken.token_value.symbol_mark == tok_CHAR)
+	if (currtoken.token_kind == symbol&&currtoken.symbol_mark == tok_CHAR)
 	{
-		currtoken = gettok();   // consume `CHAR`
-		currtoken = gettok();   // consume `(`
+		next();   // consume `CHAR`
+		next();   // consume `(`
 		if (currtoken.token_kind == literal_int)
 		{
-			int n = currtoken.token_value.int_literal;
-			currtoken = gettok();    // consume int literal
-			currtoken = gettok();    // consume `)`
+			int n = static_cast<int>(currtoken.int_literal);
+			next();    // consume int literal
+			next();    // consume `)`
 			while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 			{
-				currtoken = gettok();
+				next();
 			}
-			return llvm::make_unique<ColdefAST>(colname, literal_string, true, false, false, n);
+			return make<ColdefAST>(colname, literal_string, true, false, false, n);
 		}
-		throw std::runtime_error("char size must be int \n");
+		fail("char size must be int \n");
 		
 	}
 	return nullptr;
 }
 
-std::unique_ptr<CreateTableSimpleAST> ParseCreateTableSimpleAST()
+std::unique_ptr<CreateTableSimpleAST> Parser::ParseCreateTableSimpleAST()
 {
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
 	// consume ` CREATE TABLE `
-	currtoken = gettok();
-	currtoken = gettok();
-	auto table_name = std::move(ParseIdAST()->id);
+	next();
+	next();
+	auto table_name = ParseIdAST()->id;
 	// consume `(`
-	currtoken = gettok();
+	next();
 	std::vector<std::unique_ptr<ColdefAST>> cols;
 	auto col = ParseColdefAST();
-	col->col_name = std::move(table_name);
 	cols.push_back(std::move(col));
-	while (currtoken.token_kind == symbol&& currtoken.token_value.symbol_mark == comma_mark)
+	while (currtoken.token_kind == symbol&& currtoken.symbol_mark == comma_mark)
 	{
 		// consume `,`
-		currtoken = gettok();
+		next();
 		auto col = ParseColdefAST();
-		col-> = table_name;
 		cols.push_back(std::move(col));
 	}
 	// consume `)`
-	currtoken = gettok();
+	next();
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
 	return llvm::make_unique<CreateTableSimpleAST>(table_name, std::move(cols));
 }
 
-std::unique_ptr<OnJoinCondAST> ParseOnJoinCondAST()
+std::unique_ptr<OnJoinCondAST> Parser::ParseOnJoinCondAST()
 {
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
-	currtoken = gettok();	// consume `ON`
-	//auto cond = ParseExprAST();
-	auto cond = ParseLiteralAST();
+	next();	// consume `ON`
+	auto cond = ParseExprAST();
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
-	return llvm::make_unique<OnJoinCondAST>(cond);
+	return make<OnJoinCondAST>(std::move(cond));
 }
 
-std::unique_ptr<UsingJoinCondAST> ParseUsingJoinCondAST()
+std::unique_ptr<UsingJoinCondAST> Parser::ParseUsingJoinCondAST()
 {
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
 	//	consume `USING (`
-	currtoken = gettok(); currtoken = gettok();
+	next(); next();
 	std::vector<std::unique_ptr<TablecolAST>> cols;
-	std::string colname = ParseIdAST()->getvalue()->IdentifierStr;
-	cols.push_back(std::move(llvm::make_unique<TablecolAST>(colname)));
-	while (currtoken.token_kind == symbol&&currtoken.token_value.symbol_mark == comma_mark)
+	atom colname = ParseIdAST()->id;
+	cols.push_back(make<TablecolAST>(no_atom, colname));
+	while (currtoken.token_kind == symbol&&currtoken.symbol_mark == comma_mark)
 	{
-		currtoken = gettok();	// consume ','
-		std::string colname = ParseIdAST()->getvalue()->IdentifierStr;
-		cols.push_back(std::move(llvm::make_unique<TablecolAST>(colname)));
+		next();	// consume ','
+		atom colname = ParseIdAST()->id;
+		cols.push_back(make<TablecolAST>(no_atom, colname));
 	}
-	if (currtoken.token_kind == symbol&&currtoken.token_value.symbol_mark == right_bracket_mark)
+	if (currtoken.token_kind == symbol&&currtoken.symbol_mark == right_bracket_mark)
 	{
-		currtoken = gettok();	// consume '('
+		next();	// consume '('
 		while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 		{
-			currtoken = gettok();
+			next();
 		}
-		return llvm::make_unique<UsingJoinCondAST>(cols);
+		return make<UsingJoinCondAST>(std::move(cols));
 	}
 	else
 	{
-		throw std::runtime_error("using condition miss ')' mark");
+		fail("using condition miss ')' mark");
 	}
 	
 	
 }
 
-std::unique_ptr<TablecolAST> ParseTablecolAST()
+std::unique_ptr<TablecolAST> Parser::ParseTablecolAST()
 {
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
 	}
-	std::string table_name = ParseIdAST()->getvalue()->IdentifierStr;
-	currtoken = gettok();	// consume '.' mark
-	std::string col_name = ParseIdAST()->getvalue()->IdentifierStr;
+	auto table_name = ParseIdAST()->id;
+	next();	// consume '.' mark
+	auto col_name = ParseIdAST()->id;
 	while (currtoken.token_kind == blank || currtoken.token_kind == comment)
 	{
-		currtoken = gettok();
+		next();
+	}
+	return make<TablecolAST>(table_name, col_name);
+}
+
+
+void Parser::expect(int mark, const char* what)
+{
+	if (!is_symbol(mark))
+		fail(what);
+	next();
+}
+
+// line and column are only worked out once there is an error
+void Parser::fail(const char* what)
+{
+	std::string msg(what);
+	while (!msg.empty() && isspace(static_cast<unsigned char>(msg.back())))
+		msg.pop_back();
+	source_location loc = scanner ? scanner->locate(currtoken.offset) : source_location();
+	if (loc.line)
+		throw syntax_error(msg, currtoken.offset,
+			" at line " + std::to_string(loc.line) + ", column " + std::to_string(loc.column));
+	throw syntax_error(msg, currtoken.offset, " at byte " + std::to_string(currtoken.offset));
+}
+
+// col or table.col
+table_col Parser::ParseColumnName()
+{
+	atom first = ParseIdAST()->id;
+	if (!is_symbol(dot_mark))
+		return table_col(no_atom, first);
+	next();	// consume '.'
+	return table_col(first, ParseIdAST()->id);
+}
+
+// expr [[AS] alias], or * for every column
+std::unique_ptr<SelectExprAST> Parser::ParseSelectExprAST()
+{
+	if (is_symbol(mult_mark))
+	{
+		next();
+		return make<SelectExprAST>(nullptr, no_atom);
 	}
-	return llvm::make_unique<TablecolAST>(table_name, col_name);
+	auto expr = ParseExprAST();
+	atom alias = no_atom;
+	if (is_symbol(tok_AS))
+	{
+		next();
+		alias = ParseIdAST()->id;
+	}
+	else if (currtoken.token_kind == id)
+		alias = ParseIdAST()->id;
+	return make<SelectExprAST>(std::move(expr), alias);
+}
+
+// table [[AS] alias], ...
+std::unique_ptr<TableRefsAST> Parser::ParseTableRefsAST()
+{
+	std::vector<std::unique_ptr<TableRefAST>> refs;
+	do
+	{
+		if (!refs.empty())
+			next();	// consume ','
+		auto ref = make<TableNameAST>(ParseIdAST()->id);
+		if (is_symbol(tok_AS))
+		{
+			next();
+			ref->topalias = ParseIdAST()->id;
+		}
+		else if (currtoken.token_kind == id)
+			ref->topalias = ParseIdAST()->id;
+		refs.push_back(std::move(ref));
+	} while (is_symbol(comma_mark));
+	if (is_symbol(tok_JOIN) || is_symbol(tok_ON))
+		fail("join is not supported yet \n");
+	return make<TableRefsAST>(std::move(refs));
 }
 
+// INSERT INTO table [(col, ...)] VALUES (expr, ...) [, (expr, ...)] ...
+// with the table in the catalog the rows go into columns, see insert_column;
+// otherwise they are kept one after another in value_list
+std::unique_ptr<InsertAST> Parser::ParseInsertAST()
+{
+	next();	// consume INSERT
+	expect(tok_INTO, "expect INTO \n");
+	atom table_name = ParseIdAST()->id;
+	std::vector<atom> col_name;
+	if (is_symbol(left_bracket_mark))
+	{
+		do
+		{
+			next();	// consume '(' or ','
+			col_name.push_back(ParseIdAST()->id);
+		} while (is_symbol(comma_mark));
+		expect(right_bracket_mark, "expect ')' after column list \n");
+	}
+	expect(tok_VALUES, "expect VALUES \n");
+
+	const table_schema* schema = catalog ? catalog->find(table_name) : nullptr;
+	std::vector<insert_column> columns;
+	if (schema)
+	{
+		auto target = [&](int i)
+		{
+			insert_column col;
+			col.name = schema->cols[i].name;
+			col.dtype = schema->cols[i].dtype;
+			col.width = schema->cols[i].width;
+			columns.push_back(std::move(col));
+		};
+		if (col_name.empty())
+			for (std::size_t i = 0; i < schema->cols.size(); ++i)
+				target(static_cast<int>(i));
+		for (atom name : col_name)
+		{
+			int i = schema->column(name);
+			if (i < 0)
+			{
+				// an unknown column is left for execution to report
+				columns.clear();
+				break;
+			}
+			target(i);
+		}
+	}
+	if (!columns.empty())
+	{
+		std::size_t rows = 0;
+		do
+		{
+			if (rows)
+				next();	// consume ','
+			expect(left_bracket_mark, "expect '(' \n");
+			for (std::size_t c = 0; c < columns.size(); ++c)
+			{
+				if (c)
+					expect(comma_mark, "value count does not match column count \n");
+				insert_column& col = columns[c];
+				if (ParseInsertLiteral(col))
+					continue;
+				col.exprs.emplace_back(static_cast<std::uint32_t>(rows), ParseExprAST());
+				if (col.dtype == literal_int)
+					col.ints.push_back(0);
+				else if (col.dtype == literal_double)
+					col.doubles.push_back(0);
+				else if (col.dtype == literal_string)
+					col.strings.push_back(llvm::StringRef());
+			}
+			expect(right_bracket_mark, "value count does not match column count \n");
+			++rows;
+		} while (is_symbol(comma_mark));
+		return llvm::make_unique<InsertAST>(table_name, std::move(col_name), std::move(columns), rows);
+	}
 
+	std::vector<std::unique_ptr<ExprAST>> value_list;
+	do
+	{
+		if (!value_list.empty())
+			next();	// consume ','
+		expect(left_bracket_mark, "expect '(' \n");
+		value_list.push_back(ParseExprAST());
+		while (is_symbol(comma_mark))
+		{
+			next();
+			value_list.push_back(ParseExprAST());
+		}
+		expect(right_bracket_mark, "expect ')' \n");
+	} while (is_symbol(comma_mark));
+	return llvm::make_unique<InsertAST>(table_name, std::move(col_name), std::move(value_list));
+}
 
+// a value that is a literal of col's type, with nothing after it but ',' or ')',
+// goes straight into col; otherwise nothing is consumed and false returned
+bool Parser::ParseInsertLiteral(insert_column& col)
+{
+	std::size_t k = is_symbol(minus_mark) ? 1 : 0;
+	token t = k ? lookahead(k) : currtoken;
+	std::size_t end = k + 1;
+	if (t.token_kind == literal_string)
+	{
+		if (k)
+			return false;
+		while (lookahead(end).token_kind == literal_string)
+			++end;
+	}
+	token after = lookahead(end);
+	if (!(after.token_kind == symbol && (after.symbol_mark == comma_mark || after.symbol_mark == right_bracket_mark)))
+		return false;
+
+	bool integer = t.token_kind == literal_int || t.token_kind == literal_bigint;
+	if (col.dtype == literal_int && integer)
+		col.ints.push_back(k ? -t.int_literal : t.int_literal);
+	else if (col.dtype == literal_double && (integer || t.token_kind == literal_double))
+	{
+		double v = integer ? static_cast<double>(t.int_literal) : t.double_literal;
+		col.doubles.push_back(k ? -v : v);
+	}
+	else if (col.dtype == literal_string && t.token_kind == literal_string)
+	{
+		if (end == 1)
+			col.strings.push_back(nodes().copy(currtoken.str()));
+		else
+		{
+			// 'a' 'b' is one string; every part is in the buffer by now
+			std::string joined;
+			for (std::size_t i = 0; i < end; ++i)
+				joined += lookahead(i).str();
+			col.strings.push_back(nodes().copy(joined));
+		}
+	}
+	else
+		return false;
+	for (std::size_t i = 0; i < end; ++i)
+		next();
+	return true;
+}
+
+// DELETE FROM table [WHERE expr]
+std::unique_ptr<DeleteAST> Parser::ParseDeleteAST()
+{
+	next();	// consume DELETE
+	expect(tok_FROM, "expect FROM \n");
+	atom table_name = ParseIdAST()->id;
+	std::unique_ptr<ExprAST> where_condition = nullptr;
+	if (is_symbol(tok_WHERE))
+	{
+		next();
+		where_condition = ParseExprAST();
+	}
+	return llvm::make_unique<DeleteAST>(table_name, std::move(where_condition));
+}
+
+// PREPARE name FROM 'statement'
+// the text is only kept here, prepared_session parses it when the statement runs
+std::unique_ptr<PrepareAST> Parser::ParsePrepareAST()
+{
+	next();	// consume PREPARE
+	atom name = ParseIdAST()->id;
+	expect(tok_FROM, "expect FROM \n");
+	if (currtoken.token_kind != literal_string)
+		fail("expect the statement to prepare as a string \n");
+	llvm::StringRef text = ParseStringLiteralAST()->value;
+	return llvm::make_unique<PrepareAST>(name, text);
+}
+
+// EXECUTE name [USING expr, ...]
+std::unique_ptr<ExecuteAST> Parser::ParseExecuteAST()
+{
+	next();	// consume EXECUTE
+	atom name = ParseIdAST()->id;
+	std::vector<std::unique_ptr<ExprAST>> args;
+	if (is_symbol(tok_USING))
+	{
+		do
+		{
+			next();	// consume USING or ','
+			args.push_back(ParseExprAST());
+		} while (is_symbol(comma_mark));
+	}
+	return llvm::make_unique<ExecuteAST>(name, std::move(args));
+}
+
+// {DEALLOCATE | DROP} PREPARE name
+std::unique_ptr<DeallocateAST> Parser::ParseDeallocateAST()
+{
+	next();	// consume DEALLOCATE or DROP
+	expect(tok_PREPARE, "expect PREPARE \n");
+	return llvm::make_unique<DeallocateAST>(ParseIdAST()->id);
+}
+
+// the ';' that ends a statement is left as currtoken and skipped on the next
+// call, so an interactive session is not kept waiting for the line after it
+std::unique_ptr<StatementAST> Parser::ParseStatementAST()
+{
+	while (true)
+	{
+		while (is_symbol(semicolon_mark))
+			next();
+		if (currtoken.token_kind == eof)
+			return nullptr;
+		if (!recover)
+			return ParseOneStatementAST();
+
+		// look ahead to the ';': a statement holding a lex_error is skipped whole, unparsed
+		std::size_t k = 0;
+		token t = currtoken;
+		while (t.token_kind != eof && t.token_kind != lex_error &&
+			!(t.token_kind == symbol && t.symbol_mark == semicolon_mark))
+			t = lookahead(++k);
+		if (t.token_kind == lex_error)
+		{
+			// before next(), which may move the text t points into
+			const char* reason = lex_error_reason(t);
+			// lex_error already swallowed the ';'
+			for (std::size_t i = 0; i <= k; ++i)
+				next();
+			++skipped;
+			if (on_skip)
+				on_skip(reason, t.offset);
+			continue;
+		}
+		try
+		{
+			return ParseOneStatementAST();
+		}
+		catch (syntax_error& e)
+		{
+			while (!is_symbol(semicolon_mark) && currtoken.token_kind != eof)
+				next();
+			++skipped;
+			if (on_skip)
+				on_skip(e.reason, e.offset);
+		}
+	}
+}
+
+std::unique_ptr<StatementAST> Parser::ParseOneStatementAST()
+{
+	// the statement is built in an arena of its own: one left by the other
+	// Parse* entries is kept for take_arena(), one of a statement that fails
+	// is dropped with it
+	struct arena_scope
+	{
+		std::unique_ptr<ast_arena>& current;
+		std::unique_ptr<ast_arena> kept;
+		explicit arena_scope(std::unique_ptr<ast_arena>& current) :current(current), kept(std::move(current)) {}
+		~arena_scope() { current = std::move(kept); }
+	} scope(arena);
+	std::unique_ptr<StatementAST> stmt = nullptr;
+	params = 0;
+	if (is_symbol(tok_SELECT))
+		stmt = llvm::make_unique<SelectAST>(ParseSubqueryAST());
+	else if (is_symbol(tok_INSERT))
+		stmt = ParseInsertAST();
+	else if (is_symbol(tok_DELETE))
+		stmt = ParseDeleteAST();
+	else if (is_symbol(tok_CREATE))
+	{
+		token what = lookahead(1);
+		if (!(what.token_kind == symbol && what.symbol_mark == tok_TABLE))
+			fail("only CREATE TABLE is supported \n");
+		stmt = ParseCreateTableSimpleAST();
+	}
+	else if (is_symbol(tok_PREPARE))
+		stmt = ParsePrepareAST();
+	else if (is_symbol(tok_EXECUTE))
+		stmt = ParseExecuteAST();
+	else if (is_symbol(tok_DEALLOCATE) ||
+		(is_symbol(tok_DROP) && lookahead(1).token_kind == symbol && lookahead(1).symbol_mark == tok_PREPARE))
+		stmt = ParseDeallocateAST();
+	else
+		fail("expect a statement \n");
+	if (!is_symbol(semicolon_mark) && currtoken.token_kind != eof)
+		fail("expect ';' \n");
+	stmt->params = params;
+	// the statement's nodes are freed along with it
+	stmt->arena = std::move(arena);
+	return stmt;
+}
+
+
+// one default parser per thread, reading from default_scanner()
+
+Parser& default_parser()
+{
+	static thread_local Parser parser(default_scanner());
+	return parser;
+}
+
+void init_parser()
+{
+	default_parser().init();
+}
+
+std::unique_ptr<ExprAST> ParseExprAST()
+{
+	return default_parser().ParseExprAST();
+}
+
+std::unique_ptr<ExprAST> ParseSEAST()
+{
+	return default_parser().ParseSEAST();
+}
+
+std::unique_ptr<ExprAST> ParseLiteralAST()
+{
+	return default_parser().ParseLiteralAST();
+}
+
+std::unique_ptr<StringLiteralAST> ParseStringLiteralAST()
+{
+	return default_parser().ParseStringLiteralAST();
+}
+
+std::unique_ptr<IntLiteralAST> ParseIntLiteralAST()
+{
+	return default_parser().ParseIntLiteralAST();
+}
+
+std::unique_ptr<DoubleLiteralAST> ParseDoubleLiteralAST()
+{
+	return default_parser().ParseDoubleLiteralAST();
+}
+
+std::unique_ptr<TablecolAST> ParseTablecolAST()
+{
+	return default_parser().ParseTablecolAST();
+}
+
+std::unique_ptr<ExprAST> ParseParenExprAST()
+{
+	return default_parser().ParseParenExprAST();
+}
+
+std::unique_ptr<IdAST> ParseIdAST()
+{
+	return default_parser().ParseIdAST();
+}
+
+std::unique_ptr<CallAST> ParseCallAST()
+{
+	return default_parser().ParseCallAST();
+}
+
+std::unique_ptr<ExistsSubqueryAST> ParseExistsSubqueryAST()
+{
+	return default_parser().ParseExistsSubqueryAST();
+}
+
+std::unique_ptr<SubqueryAST> ParseSubqueryAST()
+{
+	return default_parser().ParseSubqueryAST();
+}
+
+std::unique_ptr<CreateTableSimpleAST> ParseCreateTableSimpleAST()
+{
+	return default_parser().ParseCreateTableSimpleAST();
+}
+
+std::unique_ptr<ColdefAST> ParseColdefAST()
+{
+	return default_parser().ParseColdefAST();
+}
+
+std::unique_ptr<OnJoinCondAST> ParseOnJoinCondAST()
+{
+	return default_parser().ParseOnJoinCondAST();
+}
+
+std::unique_ptr<UsingJoinCondAST> ParseUsingJoinCondAST()
+{
+	return default_parser().ParseUsingJoinCondAST();
+}
+
+std::unique_ptr<StatementAST> ParseStatementAST()
+{
+	return default_parser().ParseStatementAST();
+}
+
+std::unique_ptr<InsertAST> ParseInsertAST()
+{
+	return default_parser().ParseInsertAST();
+}
+
+std::unique_ptr<DeleteAST> ParseDeleteAST()
+{
+	return default_parser().ParseDeleteAST();
+}
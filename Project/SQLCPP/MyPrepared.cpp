@@ -0,0 +1,182 @@
+#include<string>
+#include "llvm/Support/Casting.h"
+#include"prepared.h"
+#include"scan_source.h"
+
+prepared_statement::prepared_statement(llvm::StringRef sql)
+{
+	// in recover mode an unterminated string or comment is a lex_error token,
+	// reported as a syntax_error rather than the scanner's own exception
+	Scanner scanner(llvm::make_unique<memory_source>(sql.begin(), sql.end()));
+	scanner.set_recover(true);
+	token_buffer tokens;
+	tokens.fill_all(scanner);
+	auto where = [&](std::uint64_t at)
+	{
+		source_location loc = scanner.locate(at);
+		return " at line " + std::to_string(loc.line) + ", column " + std::to_string(loc.column);
+	};
+	for (std::size_t i = 0; i < tokens.size(); ++i)
+		if (tokens.kinds[i] == lex_error)
+		{
+			token t = tokens.at(i);
+			throw syntax_error(lex_error_reason(t), t.offset, where(t.offset));
+		}
+
+	Parser parser(tokens);
+	try
+	{
+		parser.init();
+		ast = parser.ParseStatementAST();
+		if (ast && parser.ParseStatementAST())
+			throw prepare_error("only one statement can be prepared");
+	}
+	catch (syntax_error& e)
+	{
+		// a Parser over a buffer only knows the byte offset
+		throw syntax_error(e.reason, e.offset, where(e.offset));
+	}
+	if (!ast)
+		throw prepare_error("nothing to prepare");
+	if (ast->kind == prepare_stmt || ast->kind == execute_stmt || ast->kind == deallocate_stmt)
+		throw prepare_error("PREPARE, EXECUTE and DEALLOCATE cannot be prepared");
+	values.resize(ast->params);
+}
+
+param_value& prepared_statement::slot(std::size_t i)
+{
+	if (i >= values.size())
+		throw prepare_error("no parameter " + std::to_string(i + 1) + ", the statement has " +
+			std::to_string(values.size()));
+	return values[i];
+}
+
+void prepared_statement::bind_int(std::size_t i, std::int64_t v)
+{
+	param_value& p = slot(i);
+	p.type = literal_int;
+	p.int_value = v;
+}
+
+void prepared_statement::bind_double(std::size_t i, double v)
+{
+	param_value& p = slot(i);
+	p.type = literal_double;
+	p.double_value = v;
+}
+
+void prepared_statement::bind_string(std::size_t i, llvm::StringRef v)
+{
+	param_value& p = slot(i);
+	p.type = literal_string;
+	p.string_value.assign(v.data(), v.size());
+}
+
+void prepared_statement::bind(std::size_t i, const param_value& v)
+{
+	slot(i) = v;
+}
+
+void prepared_statement::clear_bindings()
+{
+	for (param_value& p : values)
+		p.type = blank;
+}
+
+bound_statement prepared_statement::execute()
+{
+	for (std::size_t i = 0; i < values.size(); ++i)
+		if (values[i].type == blank)
+			throw prepare_error("parameter " + std::to_string(i + 1) + " is not bound");
+	++runs;
+	bound_statement b;
+	b.ast = ast.get();
+	b.values = values;
+	return b;
+}
+
+// EXECUTE ... USING takes literals, numbers may have a leading '-'
+static param_value using_value(const ExprAST* e)
+{
+	param_value v;
+	bool minus = false;
+	if (auto u = llvm::dyn_cast<UnaryExprAST>(e))
+	{
+		if (u->op == minus_mark && u->operand->kind != string_expr)
+		{
+			minus = true;
+			e = u->operand.get();
+		}
+	}
+	if (auto i = llvm::dyn_cast<IntLiteralAST>(e))
+	{
+		v.type = literal_int;
+		v.int_value = minus ? -i->value : i->value;
+	}
+	else if (auto d = llvm::dyn_cast<DoubleLiteralAST>(e))
+	{
+		v.type = literal_double;
+		v.double_value = minus ? -d->value : d->value;
+	}
+	else if (auto s = llvm::dyn_cast<StringLiteralAST>(e))
+	{
+		v.type = literal_string;
+		v.string_value = s->value.str();
+	}
+	else
+		throw prepare_error("EXECUTE ... USING takes literal values only");
+	return v;
+}
+
+static std::string unknown(atom name)
+{
+	return "unknown prepared statement " + atom_text(name).str();
+}
+
+bool prepared_session::run(const StatementAST& stmt, bound_statement* executed)
+{
+	switch (stmt.kind)
+	{
+	case prepare_stmt:
+	{
+		auto& p = llvm::cast<PrepareAST>(stmt);
+		named.erase(p.name);
+		auto ps = llvm::make_unique<prepared_statement>(p.text);
+		named[p.name] = std::move(ps);
+		return true;
+	}
+	case execute_stmt:
+	{
+		auto& e = llvm::cast<ExecuteAST>(stmt);
+		prepared_statement* ps = find(e.name);
+		if (!ps)
+			throw prepare_error(unknown(e.name));
+		if (e.args.size() != ps->param_count())
+			throw prepare_error("EXECUTE " + atom_text(e.name).str() + " needs " + std::to_string(ps->param_count()) +
+				" values, got " + std::to_string(e.args.size()));
+		for (std::size_t i = 0; i < e.args.size(); ++i)
+			ps->bind(i, using_value(e.args[i].get()));
+		bound_statement b = ps->execute();
+		if (executed)
+			*executed = b;
+		return true;
+	}
+	case deallocate_stmt:
+	{
+		auto& d = llvm::cast<DeallocateAST>(stmt);
+		if (!named.erase(d.name))
+			throw prepare_error(unknown(d.name));
+		return true;
+	}
+	default:
+		if (stmt.params)
+			throw prepare_error("? is only allowed in a prepared statement");
+		return false;
+	}
+}
+
+prepared_statement* prepared_session::find(atom name)
+{
+	auto found = named.find(name);
+	return found == named.end() ? nullptr : found->second.get();
+}
@@ -0,0 +1,204 @@
+#include<algorithm>
+#include<deque>
+#include<future>
+#include<unordered_map>
+#include"script_loader.h"
+#include"scan_parallel.h"
+#include"scan_source.h"
+
+static bool ends_statement(const token_buffer& b, std::size_t i)
+{
+	return (b.kinds[i] == symbol && b.payload[i] == semicolon_mark) || b.kinds[i] == lex_error;
+}
+
+static bool is_symbol_at(const token_buffer& b, std::size_t i, int mark)
+{
+	return i < b.size() && b.kinds[i] == symbol && b.payload[i] == mark;
+}
+
+struct script_span
+{
+	std::size_t first = 0;
+	std::size_t count = 0;					// with its ';' or lex_error
+	const table_schema* table = nullptr;	// INSERT: its table as of here
+	bool parsed = false;					// CREATE, done before the others
+};
+
+// one Parser over the script's tokens, with the tables its INSERTs go into
+class parse_job
+{
+	const token_buffer& tokens;
+	memory_source source;		// its newline index grows with the errors located
+	Parser parser;
+	schema_catalog tables;
+	std::unordered_map<atom, const table_schema*> loaded;
+
+	std::string where(std::uint64_t at)
+	{
+		source_location loc = source.locate(at);
+		return " at line " + std::to_string(loc.line) + ", column " + std::to_string(loc.column);
+	}
+
+public:
+	parse_job(const token_buffer& tokens, const char* begin, const char* end) :
+		tokens(tokens), source(begin, end), parser(tokens) {}
+
+	void parse(const script_span& s, script_loader::statement& out)
+	{
+		out.offset = tokens.offsets[s.first];
+		std::size_t last = s.first + s.count - 1;
+		if (tokens.kinds[last] == lex_error)
+		{
+			token t = tokens.at(last);
+			out.error = lex_error_reason(t) + where(t.offset);
+			return;
+		}
+		parser.set_catalog(nullptr);
+		if (s.table)
+		{
+			// a copy per table and job, not per statement
+			const table_schema*& have = loaded[s.table->name];
+			if (have != s.table)
+			{
+				tables.add(*s.table);
+				have = s.table;
+			}
+			parser.set_catalog(&tables);
+		}
+		try
+		{
+			parser.init(s.first);
+			out.ast = parser.ParseStatementAST();
+		}
+		catch (syntax_error& e)
+		{
+			out.error = e.reason + where(e.offset);
+		}
+	}
+};
+
+std::size_t script_loader::run(const char* begin, const char* end, const std::function<void(statement&)>& execute)
+{
+	token_buffer tokens;
+	lex_parallel(begin, end, tokens, pool, piece_bytes, true);
+
+	std::vector<script_span> spans;
+	for (std::size_t i = 0; i < tokens.size();)
+	{
+		if (is_symbol_at(tokens, i, semicolon_mark))
+		{
+			++i;
+			continue;
+		}
+		script_span s;
+		s.first = i;
+		while (i < tokens.size() && !ends_statement(tokens, i))
+			++i;
+		i += i < tokens.size();
+		s.count = i - s.first;
+		spans.push_back(s);
+	}
+	std::vector<statement> out(spans.size());
+
+	// CREATE first, in order, so each INSERT knows its table as of where it stands;
+	// the caller's catalog is copied since it changes while the jobs still run
+	schema_catalog before;
+	if (catalog)
+		before = *catalog;
+	std::deque<table_schema> created;
+	std::unordered_map<atom, const table_schema*> latest;	// null: a table we cannot describe
+	parse_job ddl(tokens, begin, end);
+	for (std::size_t k = 0; k < spans.size(); ++k)
+	{
+		script_span& s = spans[k];
+		std::size_t first = s.first;
+		if (is_symbol_at(tokens, first, tok_CREATE))
+		{
+			ddl.parse(s, out[k]);
+			s.parsed = true;
+			if (!out[k].ast)
+				continue;
+			table_schema table;
+			bool described = table_schema::declared_by(*out[k].ast, table);
+			if (table.name == no_atom)
+				continue;
+			atom name = table.name;
+			if (described)
+			{
+				created.push_back(std::move(table));
+				latest[name] = &created.back();
+			}
+			else
+				latest[name] = nullptr;
+		}
+		else if (is_symbol_at(tokens, first, tok_INSERT) && is_symbol_at(tokens, first + 1, tok_INTO) &&
+			first + 2 < first + s.count && tokens.kinds[first + 2] == id)
+		{
+			atom name = static_cast<atom>(tokens.payload[first + 2]);
+			auto found = latest.find(name);
+			s.table = found != latest.end() ? found->second : before.find(name);
+		}
+	}
+
+	// batches of whole statements, at least batch_tokens each
+	std::vector<std::size_t> batch{ 0 };
+	for (std::size_t k = 0, n = 0; k < spans.size(); ++k)
+	{
+		n += spans[k].count;
+		if (n >= batch_tokens || k + 1 == spans.size())
+		{
+			batch.push_back(k + 1);
+			n = 0;
+		}
+	}
+	// a window of batches in flight, the next submitted as each is executed
+	std::vector<std::future<void>> parsed(batch.size() - 1);
+	auto submit = [&](std::size_t b)
+	{
+		parsed[b] = pool.submit([&, b]
+		{
+			parse_job job(tokens, begin, end);
+			for (std::size_t k = batch[b]; k < batch[b + 1]; ++k)
+				if (!spans[k].parsed)
+					job.parse(spans[k], out[k]);
+		});
+	};
+	std::size_t window = std::min(parsed.size(), 2 * pool.size());
+	for (std::size_t b = 0; b < window; ++b)
+		submit(b);
+
+	// handed to execute in source order while later batches are still parsing;
+	// a statement is dropped once executed, so memory stays bounded by the window
+	try
+	{
+		for (std::size_t b = 0; b < parsed.size(); ++b)
+		{
+			parsed[b].get();
+			for (std::size_t k = batch[b]; k < batch[b + 1]; ++k)
+			{
+				if (catalog && out[k].ast)
+					catalog->apply(*out[k].ast);
+				execute(out[k]);
+				out[k] = statement();
+			}
+			if (b + window < parsed.size())
+				submit(b + window);
+		}
+	}
+	catch (...)
+	{
+		// the jobs still running use tokens and out
+		for (auto& p : parsed)
+			if (p.valid())
+				p.wait();
+		throw;
+	}
+	return spans.size();
+}
+
+std::vector<script_loader::statement> script_loader::load(const char* begin, const char* end)
+{
+	std::vector<statement> all;
+	run(begin, end, [&](statement& s) { all.push_back(std::move(s)); });
+	return all;
+}
@@ -0,0 +1,369 @@
+#include<algorithm>
+#include<cerrno>
+#include<cstring>
+#include<string>
+#include<vector>
+#include<zlib.h>
+#ifdef LLVMSQL_WITH_ZSTD
+#include<zstd.h>
+#endif
+#include"scan_source.h"
+
+#ifdef _WIN32
+#include<fcntl.h>
+#include<io.h>
+#include<windows.h>
+#define source_read _read
+#define source_close _close
+#define source_lseek _lseek
+#define source_open(path) _open(path, _O_RDONLY | _O_BINARY)
+#else
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#define source_read read
+#define source_close close
+#define source_lseek lseek
+#define source_open(path) open(path, O_RDONLY)
+#endif
+
+static std::size_t read_retry(int fd, char* dst, std::size_t n)
+{
+	int got;
+	do
+		got = source_read(fd, dst, static_cast<unsigned>(n));
+	while (got < 0 && errno == EINTR);
+	if (got < 0)
+		throw source_error(std::string("read failed: ") + strerror(errno));
+	return static_cast<std::size_t>(got);
+}
+
+source_location scan_source::locate(std::uint64_t at)
+{
+	source_location loc;
+	if (at < origin_offset || at > offset(lim))
+		return loc;
+	// the window slid since the index was built
+	if (indexed_from != origin_offset)
+	{
+		newlines.clear();
+		indexed_from = indexed_to = origin_offset;
+	}
+	const char* p = origin + (indexed_to - origin_offset);
+	const char* target = origin + (at - origin_offset);
+	while (p < target)
+	{
+		auto nl = static_cast<const char*>(memchr(p, '\n', target - p));
+		if (!nl)
+		{
+			p = target;
+			break;
+		}
+		newlines.push_back(offset(nl));
+		p = nl + 1;
+	}
+	indexed_to = std::max(indexed_to, at);
+
+	std::size_t n = std::lower_bound(newlines.begin(), newlines.end(), at) - newlines.begin();
+	loc.line = static_cast<unsigned>(lines_before + n + 1);
+	loc.column = static_cast<unsigned>(at - (n ? newlines[n - 1] + 1 : line_start) + 1);
+	return loc;
+}
+
+string_source::string_source(std::string s) :text(std::move(s))
+{
+	origin = cur = text.data();
+	lim = text.data() + text.size();
+}
+
+memory_source::memory_source(const char* begin, const char* end, std::uint64_t base) :
+	memory_source(begin, end, base, 0, base) {}
+
+memory_source::memory_source(const char* begin, const char* end, std::uint64_t base, std::uint64_t lines_before,
+	std::uint64_t line_start)
+{
+	origin = cur = begin;
+	origin_offset = base;
+	lim = end;
+	this->lines_before = lines_before;
+	this->line_start = line_start;
+}
+
+#ifdef _WIN32
+
+mmap_source::mmap_source(const std::string& path)
+{
+	file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		throw source_error("cannot open " + path);
+	LARGE_INTEGER len;
+	GetFileSizeEx(file, &len);
+	size = static_cast<std::size_t>(len.QuadPart);
+	if (size != 0)
+	{
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping)
+			base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!base)
+		{
+			if (mapping)
+				CloseHandle(mapping);
+			CloseHandle(file);
+			throw source_error("cannot map " + path);
+		}
+	}
+	origin = cur = static_cast<const char*>(base);
+	lim = cur + size;
+}
+
+mmap_source::~mmap_source()
+{
+	if (base)
+		UnmapViewOfFile(base);
+	if (mapping)
+		CloseHandle(mapping);
+	CloseHandle(file);
+}
+
+#else
+
+mmap_source::mmap_source(const std::string& path)
+{
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw source_error("cannot open " + path + ": " + strerror(errno));
+	struct stat st;
+	if (fstat(fd, &st) != 0)
+	{
+		close(fd);
+		throw source_error("cannot stat " + path + ": " + strerror(errno));
+	}
+	size = static_cast<std::size_t>(st.st_size);
+	if (size != 0)
+	{
+		base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (base == MAP_FAILED)
+		{
+			close(fd);
+			throw source_error("cannot map " + path + ": " + strerror(errno));
+		}
+		madvise(base, size, MADV_SEQUENTIAL);
+	}
+	close(fd);
+	origin = cur = static_cast<const char*>(base);
+	lim = cur + size;
+}
+
+mmap_source::~mmap_source()
+{
+	if (base)
+		munmap(base, size);
+}
+
+#endif
+
+buffered_source::buffered_source(int fd, std::size_t block) :buf(std::max<std::size_t>(block, 1)), fd(fd)
+{
+	origin = cur = lim = buf.data();
+}
+
+std::size_t buffered_source::read_some(char* dst, std::size_t n)
+{
+	return read_retry(fd, dst, n);
+}
+
+bool buffered_source::fill(std::size_t n)
+{
+	while (static_cast<std::size_t>(lim - cur) < n)
+	{
+		if (at_eof)
+			return false;
+
+		// slide the live part (from the token start) to the front of the buffer
+		const char* keep = (mark && mark < cur) ? mark : cur;
+		std::size_t live = lim - keep, at = cur - keep, marked = mark ? mark - keep : 0;
+		// the lines of what is dropped, for locate()
+		for (const char* p = buf.data(); (p = static_cast<const char*>(memchr(p, '\n', keep - p))) != nullptr; ++p)
+		{
+			++lines_before;
+			line_start = offset(p) + 1;
+		}
+		origin_offset = offset(keep);
+		if (keep != buf.data())
+			memmove(buf.data(), keep, live);
+		// only grows when a single token outruns a whole block; a full buffer
+		// always grows, or a block of 1 would read 0 bytes and look like the end
+		if (live == buf.size() || buf.size() - live < buf.size() / 2)
+			buf.resize(buf.size() * 2);
+
+		std::size_t got = read_some(buf.data() + live, buf.size() - live);
+		if (got == 0)
+			at_eof = true;
+
+		origin = buf.data();
+		cur = buf.data() + at;
+		lim = buf.data() + live + got;
+		if (mark)
+			mark = buf.data() + marked;
+	}
+	return true;
+}
+
+/// compressed_source
+
+struct compressed_source::codec
+{
+	enum { gzip, zstd } format = gzip;
+	std::vector<char> in;
+	std::size_t in_pos = 0, in_len = 0;
+	bool in_eof = false;
+	bool mid_frame = false;	// a gzip member or zstd frame is started but not finished
+	z_stream z = {};
+#ifdef LLVMSQL_WITH_ZSTD
+	ZSTD_DStream* zs = nullptr;
+#endif
+};
+
+compressed_source::compressed_source(int fd, bool owns_fd, std::size_t block)
+	:buffered_source(fd, block), dec(new codec), owns_fd(owns_fd)
+{
+	codec& c = *dec;
+	auto fail = [&](const char* why)
+	{
+		if (owns_fd)
+			source_close(fd);
+		throw source_error(why);
+	};
+	// room for the 4 magic bytes whatever the block
+	c.in.resize(std::max<std::size_t>(block, 4));
+	// the magic bytes may come in more than one read on a pipe
+	while (c.in_len < 4)
+	{
+		std::size_t got = read_retry(fd, c.in.data() + c.in_len, c.in.size() - c.in_len);
+		if (got == 0)
+			break;
+		c.in_len += got;
+	}
+	c.in_eof = c.in_len < 4;
+
+	const unsigned char* magic = reinterpret_cast<const unsigned char*>(c.in.data());
+	if (c.in_len >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+	{
+		c.format = codec::gzip;
+		if (inflateInit2(&c.z, 16 + MAX_WBITS) != Z_OK)
+			fail("cannot start gzip decoder");
+	}
+	else if (c.in_len >= 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd)
+	{
+#ifdef LLVMSQL_WITH_ZSTD
+		c.format = codec::zstd;
+		c.zs = ZSTD_createDStream();
+		if (!c.zs || ZSTD_isError(ZSTD_initDStream(c.zs)))
+			fail("cannot start zstd decoder");
+#else
+		fail("zstd input needs a build with LLVMSQL_WITH_ZSTD");
+#endif
+	}
+	else
+		fail("input is neither gzip nor zstd");
+}
+
+compressed_source::~compressed_source()
+{
+	if (dec->format == codec::gzip)
+		inflateEnd(&dec->z);
+#ifdef LLVMSQL_WITH_ZSTD
+	if (dec->zs)
+		ZSTD_freeDStream(dec->zs);
+#endif
+	if (owns_fd)
+		source_close(fd);
+}
+
+std::size_t compressed_source::read_some(char* dst, std::size_t n)
+{
+	codec& c = *dec;
+	while (true)
+	{
+		if (c.in_pos == c.in_len)
+		{
+			if (!c.in_eof)
+			{
+				c.in_len = read_retry(fd, c.in.data(), c.in.size());
+				c.in_pos = 0;
+				c.in_eof = c.in_len == 0;
+			}
+			if (c.in_eof)
+			{
+				if (c.mid_frame)
+					throw source_error("compressed input is truncated");
+				return 0;
+			}
+		}
+
+		std::size_t produced;
+		if (c.format == codec::gzip)
+		{
+			c.z.next_in = reinterpret_cast<Bytef*>(c.in.data() + c.in_pos);
+			c.z.avail_in = static_cast<uInt>(c.in_len - c.in_pos);
+			c.z.next_out = reinterpret_cast<Bytef*>(dst);
+			c.z.avail_out = static_cast<uInt>(n);
+			int r = inflate(&c.z, Z_NO_FLUSH);
+			c.in_pos = c.in_len - c.z.avail_in;
+			produced = n - c.z.avail_out;
+			if (r == Z_STREAM_END)
+			{
+				// another member may follow
+				c.mid_frame = false;
+				inflateReset(&c.z);
+			}
+			else if (r == Z_OK || r == Z_BUF_ERROR)
+				c.mid_frame = true;
+			else
+				throw source_error(std::string("gzip: ") + (c.z.msg ? c.z.msg : "corrupt input"));
+		}
+		else
+		{
+#ifdef LLVMSQL_WITH_ZSTD
+			ZSTD_inBuffer in = { c.in.data(), c.in_len, c.in_pos };
+			ZSTD_outBuffer out = { dst, n, 0 };
+			std::size_t r = ZSTD_decompressStream(c.zs, &out, &in);
+			if (ZSTD_isError(r))
+				throw source_error(std::string("zstd: ") + ZSTD_getErrorName(r));
+			c.in_pos = in.pos;
+			produced = out.pos;
+			c.mid_frame = r != 0;
+#else
+			produced = 0;
+#endif
+		}
+		if (produced)
+			return produced;
+	}
+}
+
+std::unique_ptr<scan_source> open_source(const std::string& path)
+{
+	int fd = source_open(path.c_str());
+	if (fd < 0)
+		throw source_error("cannot open " + path + ": " + strerror(errno));
+	unsigned char magic[4] = {};
+	std::size_t got = 0;
+	try
+	{
+		got = read_retry(fd, reinterpret_cast<char*>(magic), sizeof magic);
+	}
+	catch (...)
+	{
+		source_close(fd);
+		throw;
+	}
+	bool gz = got >= 2 && magic[0] == 0x1f && magic[1] == 0x8b;
+	bool zst = got >= 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd;
+	if ((gz || zst) && source_lseek(fd, 0, SEEK_SET) == 0)
+		return std::unique_ptr<scan_source>(new compressed_source(fd, true));
+	source_close(fd);
+	return std::unique_ptr<scan_source>(new mmap_source(path));
+}
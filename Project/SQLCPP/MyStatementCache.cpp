@@ -0,0 +1,228 @@
+#include"statement_cache.h"
+
+// a literal in shape; every other token is kind << 32 | payload
+constexpr std::int64_t literal_slot = static_cast<std::int64_t>(literal_int) << 32;
+
+static bool is_literal(int kind)
+{
+	return kind == literal_int || kind == literal_bigint || kind == literal_double || kind == literal_string;
+}
+
+static std::int64_t shape_of(int kind, std::int64_t payload)
+{
+	return static_cast<std::int64_t>(kind) << 32 | static_cast<std::uint32_t>(payload);
+}
+
+statement_cache::statement_cache(std::size_t capacity, std::size_t max_params) :
+	capacity(capacity ? capacity : 1), max_params(max_params)
+{
+}
+
+void statement_cache::clear()
+{
+	index.clear();
+	entries.clear();
+}
+
+void statement_cache::set_catalog(const schema_catalog* tables)
+{
+	catalog = tables;
+	catalog_version = tables ? tables->version() : 0;
+	clear();
+}
+
+void statement_cache::start()
+{
+	shape.clear();
+	hash = 14695981039346656037ull;
+	literals = 0;
+	in_string = false;
+	templated = true;
+}
+
+void statement_cache::add(const token_buffer& tokens, std::size_t i)
+{
+	int kind = tokens.kinds[i];
+	std::int64_t payload = tokens.payload[i];
+	if (kind == symbol && payload == semicolon_mark)
+		return;
+	bool string = kind == literal_string;
+	if (string && in_string)
+	{
+		// 'a' 'b' is one literal
+		if (literals <= max_params)
+			values[literals - 1].string_value.append(tokens.text, payload, tokens.lengths[i]);
+		return;
+	}
+	in_string = string;
+
+	std::int64_t v;
+	if (is_literal(kind))
+	{
+		v = literal_slot;
+		if (literals < max_params)
+		{
+			if (literals == values.size())
+				values.emplace_back();
+			param_value& p = values[literals];
+			token t = tokens.at(i);
+			if (string)
+			{
+				p.type = literal_string;
+				p.string_value.assign(t.text, t.length);
+			}
+			else if (kind == literal_double)
+			{
+				p.type = literal_double;
+				p.double_value = t.double_literal;
+			}
+			else
+			{
+				p.type = literal_int;
+				p.int_value = t.int_literal;
+			}
+		}
+		++literals;
+	}
+	else
+	{
+		v = shape_of(kind, payload);
+		// a ? of its own would be numbered among the literals
+		if (kind == lex_error || (kind == symbol && payload == qusetion_mark))
+			templated = false;
+	}
+	shape.push_back(v);
+	hash = (hash ^ static_cast<std::uint64_t>(v)) * 1099511628211ull;
+}
+
+bound_statement statement_cache::next(Scanner& scanner)
+{
+	own.clear();
+	start();
+	// the shape is hashed as the tokens come in
+	for (token t = scanner.gettok(); t.token_kind != eof; t = scanner.gettok())
+	{
+		bool semicolon = t.token_kind == symbol && t.symbol_mark == semicolon_mark;
+		if (semicolon && own.size() == 0)
+			continue;
+		own.push(t);
+		add(own, own.size() - 1);
+		if (semicolon || t.token_kind == lex_error)
+			break;
+	}
+	return finish(own, 0, own.size());
+}
+
+bound_statement statement_cache::get(const token_buffer& tokens, std::size_t first, std::size_t count)
+{
+	start();
+	for (std::size_t i = first; i < first + count; ++i)
+		add(tokens, i);
+	return finish(tokens, first, count);
+}
+
+bound_statement statement_cache::parse_as_written(const token_buffer& tokens, std::size_t first)
+{
+	Parser parser(tokens);
+	parser.set_catalog(catalog);
+	parser.init(first);
+	auto ast = parser.ParseStatementAST();
+	// no values come with it, as prepared_session would say
+	if (ast && ast->params)
+		throw prepare_error("? is only allowed in a prepared statement");
+	as_written = std::move(ast);
+	bound_statement b;
+	b.ast = as_written.get();
+	return b;
+}
+
+bound_statement statement_cache::finish(const token_buffer& tokens, std::size_t first, std::size_t count)
+{
+	as_written = nullptr;
+	if (shape.empty())
+		return bound_statement();
+	std::int64_t head = shape.front();
+	if (!templated || literals > max_params ||
+		!(head == shape_of(symbol, tok_SELECT) || head == shape_of(symbol, tok_INSERT) || head == shape_of(symbol, tok_DELETE)))
+	{
+		++uncached;
+		return parse_as_written(tokens, first);
+	}
+
+	if (catalog && catalog->version() != catalog_version)
+	{
+		// parsed against tables that have changed since
+		clear();
+		catalog_version = catalog->version();
+	}
+	bound_statement b;
+	b.values = llvm::ArrayRef<param_value>(values.data(), literals);
+	auto found = index.find(hash);
+	if (found != index.end() && found->second->shape == shape)
+	{
+		entries.splice(entries.begin(), entries, found->second);
+		if (!entries.front().ast)
+		{
+			++uncached;
+			return parse_as_written(tokens, first);
+		}
+		++hits;
+		b.ast = entries.front().ast.get();
+		return b;
+	}
+
+	// new shape: parse it once with a ? for every literal
+	++misses;
+	with_params.clear();
+	bool string_before = false;
+	for (std::size_t i = first; i < first + count; ++i)
+	{
+		int kind = tokens.kinds[i];
+		if (kind == literal_string && string_before)
+			continue;
+		string_before = kind == literal_string;
+		token t = tokens.at(i);
+		if (is_literal(kind))
+		{
+			std::uint64_t at = t.offset;
+			t = token();
+			t.token_kind = symbol;
+			t.symbol_mark = qusetion_mark;
+			t.offset = at;
+		}
+		with_params.push(t);
+	}
+	std::unique_ptr<StatementAST> ast;
+	try
+	{
+		Parser parser(with_params);
+		parser.set_catalog(catalog);
+		parser.init();
+		ast = parser.ParseStatementAST();
+	}
+	catch (syntax_error&)
+	{
+	}
+	if (ast && ast->params != literals)
+		ast = nullptr;
+
+	if (found != index.end())
+	{
+		// same hash, another shape: the newer one takes the slot
+		entries.erase(found->second);
+		index.erase(found);
+	}
+	entries.push_front(entry{ hash, shape, std::move(ast) });
+	index[hash] = entries.begin();
+	if (entries.size() > capacity)
+	{
+		index.erase(entries.back().hash);
+		entries.pop_back();
+		++evictions;
+	}
+
+	if (!entries.front().ast)
+		return parse_as_written(tokens, first);
+	b.ast = entries.front().ast.get();
+	return b;
+}
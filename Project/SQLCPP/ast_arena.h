@@ -0,0 +1,68 @@
+#pragma once
+
+#ifndef llvmsql_ast_arena
+#define llvmsql_ast_arena
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Allocator.h"
+
+/// ast_arena - bump-pointer memory for the nodes of one statement
+/// The Parser places every node it builds here and hands the arena to the
+/// StatementAST it returns, so a statement's nodes are released in one go
+/// instead of one free per node.
+class ast_arena
+{
+public:
+	void* allocate(std::size_t size, std::size_t align)
+	{
+		++count;
+		return slab.Allocate(size, align);
+	}
+	// a copy of s that lives as long as the arena
+	llvm::StringRef copy(llvm::StringRef s)
+	{
+		if (s.empty())
+			return llvm::StringRef();
+		char* p = static_cast<char*>(allocate(s.size(), 1));
+		memcpy(p, s.data(), s.size());
+		return llvm::StringRef(p, s.size());
+	}
+
+	// a copy of n trivially copyable values
+	template<class T>
+	llvm::ArrayRef<T> copy(const T* values, std::size_t n)
+	{
+		if (n == 0)
+			return llvm::ArrayRef<T>();
+		T* p = static_cast<T*>(allocate(n * sizeof(T), alignof(T)));
+		memcpy(p, values, n * sizeof(T));
+		return llvm::ArrayRef<T>(p, n);
+	}
+
+	std::size_t allocations() const { return count; }
+	std::size_t bytes() const { return slab.getBytesAllocated(); }
+	std::size_t reserved() const { return slab.getTotalMemory(); }
+
+private:
+	llvm::BumpPtrAllocator slab;
+	std::size_t count = 0;
+};
+
+/// ast_node - base of the AST classes
+/// Nodes are created with new (arena) T(...) only: there is no plain operator
+/// new, so one cannot land on the heap by mistake.  Deleting a node (from a
+/// unique_ptr) runs its destructor and gives no memory back, the arena does.
+class ast_node
+{
+public:
+	// nodes hold pointers, ints and doubles
+	static void* operator new(std::size_t size, ast_arena& arena) { return arena.allocate(size, alignof(double)); }
+	static void operator delete(void*, ast_arena&) {}
+	static void operator delete(void*) {}
+};
+
+#endif
@@ -0,0 +1,641 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include"llvmsql.h"
+#include"catalog.h"
+#include"incremental.h"
+#include"prepared.h"
+#include"statement_cache.h"
+#include"scan_kernels.h"
+#include"scan_parallel.h"
+#include"script_loader.h"
+#include"scan_source.h"
+
+#ifdef _WIN32
+#include<windows.h>
+#include<psapi.h>
+#else
+#include<sys/resource.h>
+#endif
+
+// bench - scanner and parser throughput on generated scripts
+//   bench [--json] [rows] [threads]
+// Every corpus comes from a fixed seed, so the same rows give the same bytes
+// on every run and every version.  With --json each measurement is one JSON
+// object per line, for diffing between builds.
+
+// every allocation goes through here so a phase can count its own
+static std::atomic<std::size_t> alloc_count{ 0 }, heap_live{ 0 }, heap_peak{ 0 };
+
+constexpr std::size_t alloc_header = 16;	// keeps the user pointer 16-aligned
+
+void* operator new(std::size_t n)
+{
+	char* p = static_cast<char*>(std::malloc(n + alloc_header));
+	if (!p)
+		throw std::bad_alloc();
+	*reinterpret_cast<std::size_t*>(p) = n;
+	alloc_count.fetch_add(1, std::memory_order_relaxed);
+	std::size_t live = heap_live.fetch_add(n, std::memory_order_relaxed) + n;
+	std::size_t peak = heap_peak.load(std::memory_order_relaxed);
+	while (live > peak && !heap_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+		;
+	return p + alloc_header;
+}
+
+void operator delete(void* q) noexcept
+{
+	if (!q)
+		return;
+	char* p = static_cast<char*>(q) - alloc_header;
+	heap_live.fetch_sub(*reinterpret_cast<std::size_t*>(p), std::memory_order_relaxed);
+	std::free(p);
+}
+
+void* operator new[](std::size_t n) { return operator new(n); }
+void operator delete[](void* q) noexcept { operator delete(q); }
+void operator delete(void* q, std::size_t) noexcept { operator delete(q); }
+void operator delete[](void* q, std::size_t) noexcept { operator delete(q); }
+
+// process high-water mark in KB; it only grows, so per phase it is the peak so far
+static std::size_t peak_rss_kb()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS pmc;
+	GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof pmc);
+	return pmc.PeakWorkingSetSize / 1024;
+#else
+	rusage ru;
+	getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+	return ru.ru_maxrss / 1024;
+#else
+	return ru.ru_maxrss;
+#endif
+#endif
+}
+
+static std::string numeric_corpus(std::size_t rows)
+{
+	std::mt19937 rng(20240229);
+	std::uniform_int_distribution<int> pick(0, 5), digits(1, 9);
+	std::string out = "INSERT INTO t VALUES\n";
+	char buf[64];
+	for (std::size_t r = 0; r < rows; ++r)
+	{
+		out += r ? ",(" : "(";
+		for (int c = 0; c < 8; ++c)
+		{
+			unsigned v = rng();
+			switch (pick(rng))
+			{
+			case 0: snprintf(buf, sizeof buf, "%u", v % 100); break;
+			case 1: snprintf(buf, sizeof buf, "%u", v); break;
+			case 2: snprintf(buf, sizeof buf, "%u.%u", v % 10000, v % 1000); break;
+			case 3: snprintf(buf, sizeof buf, ".%u", v % 100000); break;
+			case 4: snprintf(buf, sizeof buf, "%u.%ue-%d", v % 10, v % 1000, digits(rng)); break;
+			default: snprintf(buf, sizeof buf, "%ue%d", v % 1000, digits(rng)); break;
+			}
+			if (c)
+				out += ", ";
+			out += buf;
+		}
+		out += ")\n";
+	}
+	out += ";\n";
+	return out;
+}
+
+// wide CHAR(255)/VARCHAR rows, one value in sixteen carries escapes
+static std::string string_corpus(std::size_t rows)
+{
+	std::mt19937 rng(20240302);
+	std::uniform_int_distribution<int> len(8, 255), letter('a', 'z'), escaped(0, 15);
+	std::string out = "INSERT INTO t VALUES\n";
+	for (std::size_t r = 0; r < rows / 4; ++r)
+	{
+		out += r ? ",( " : "( ";
+		for (int c = 0; c < 6; ++c)
+		{
+			if (c)
+				out += " , ";
+			out += '\'';
+			int n = len(rng);
+			bool esc = escaped(rng) == 0;
+			for (int i = 0; i < n; ++i)
+			{
+				if (esc && i % 40 == 39)
+					out += i % 80 == 79 ? "\\n" : "''";
+				else
+					out += static_cast<char>(letter(rng));
+			}
+			out += '\'';
+		}
+		out += " )\n";
+	}
+	out += ";\n";
+	return out;
+}
+
+// wide SELECT lists of qualified columns and aliases
+static std::string identifier_corpus(std::size_t rows)
+{
+	std::mt19937 rng(20240303);
+	std::uniform_int_distribution<int> pick(0, 999), cols(4, 24);
+	std::string out;
+	for (std::size_t r = 0; r < rows / 8; ++r)
+	{
+		out += "SELECT ";
+		for (int c = 0, n = cols(rng); c < n; ++c)
+		{
+			if (c)
+				out += ", ";
+			out += "orders_" + std::to_string(pick(rng) % 7) + ".customer_attribute_" + std::to_string(pick(rng)) +
+				" AS alias_" + std::to_string(c);
+		}
+		out += " FROM orders_0 WHERE region_id = account_id;\n";
+	}
+	return out;
+}
+
+// WHERE clauses dense in operators and punctuation
+static std::string operator_corpus(std::size_t rows)
+{
+	static const char* const ops[] = { "<=>", "<<", ">>", ">=", "<=", "<>", "!=", "&&", "||", ":=",
+		"=", "<", ">", "+", "-", "*", "/", "%", "&", "|", "^", "~", "!" };
+	std::mt19937 rng(20240305);
+	std::uniform_int_distribution<int> pick(0, sizeof(ops) / sizeof(ops[0]) - 1), terms(4, 16);
+	std::string out;
+	for (std::size_t r = 0; r < rows / 4; ++r)
+	{
+		out += "SELECT a FROM t WHERE (a";
+		for (int i = 0, n = terms(rng); i < n; ++i)
+			out += std::string(" ") + ops[pick(rng)] + " (b" + std::to_string(i) + "),c[" + std::to_string(i) + "].d";
+		out += ");\n";
+	}
+	return out;
+}
+
+static void nested_condition(std::string& out, std::mt19937& rng, int depth)
+{
+	static const char* const cmp[] = { "=", "<>", "<", "<=", ">", ">=" };
+	std::uniform_int_distribution<int> pick(0, 9), col(0, 63), lit(0, 99999);
+	int p = pick(rng);
+	if (depth == 0 || p == 0)
+	{
+		int c = col(rng);
+		if (p == 1)
+			out += "c" + std::to_string(c) + " IS NOT NULL";
+		else if (p == 2)
+			out += "c" + std::to_string(c) + " IN (" + std::to_string(lit(rng)) + ", " + std::to_string(lit(rng)) +
+				", " + std::to_string(lit(rng)) + ")";
+		else
+			out += "t.c" + std::to_string(c) + " " + cmp[c % 6] + " " + std::to_string(lit(rng)) +
+				(c % 3 ? "" : " * 2 + c" + std::to_string(c + 1));
+		return;
+	}
+	out += '(';
+	// wide near the leaves, one long spine above them
+	if (depth <= 3)
+		nested_condition(out, rng, depth - 1);
+	else
+		nested_condition(out, rng, 0);
+	out += p % 2 ? " AND " : " OR ";
+	nested_condition(out, rng, depth - 1);
+	out += ')';
+}
+
+// filters generated by a query builder: deep, parenthesised AND/OR trees
+static std::string nested_where_corpus(std::size_t rows)
+{
+	std::mt19937 rng(20240306);
+	std::uniform_int_distribution<int> depth(8, 32);
+	std::string out;
+	for (std::size_t r = 0; r < rows / 16; ++r)
+	{
+		out += "SELECT c0, c1 FROM t WHERE ";
+		nested_condition(out, rng, depth(rng));
+		out += ";\n";
+	}
+	return out;
+}
+
+// query-builder filters at full width: a 100k-term AND chain and a
+// 100k-value IN list, each one node (LogicalExprAST, InListAST) over its terms,
+// then 100k levels of ((c0 OR c1) AND c2) OR ... and a 100k-term sum, which
+// must parse and be freed without a deep native stack
+constexpr int wide_terms = 100000;
+
+static std::string wide_where_corpus(std::size_t rows)
+{
+	std::mt19937 rng(20240307);
+	std::uniform_int_distribution<int> col(0, 63), lit(0, 99999);
+	std::string out;
+	for (std::size_t r = 0; r == 0 || r < rows / wide_terms; ++r)
+	{
+		out += "SELECT c0 FROM t WHERE ";
+		for (int i = 0; i < wide_terms; ++i)
+			out += (i ? " AND c" : "c") + std::to_string(col(rng)) + " <> " + std::to_string(lit(rng));
+		out += ";\nSELECT c0 FROM t WHERE c1 IN (";
+		for (int i = 0; i < wide_terms; ++i)
+			out += (i ? ", " : "") + std::to_string(lit(rng));
+		out += ");\nSELECT c0 FROM t WHERE " + std::string(wide_terms - 1, '(') + "c0";
+		for (int i = 1; i < wide_terms; ++i)
+			out += (i % 2 ? " OR c" : " AND c") + std::to_string(col(rng)) + ")";
+		out += ";\nSELECT c0 FROM t WHERE c0";
+		for (int i = 1; i < wide_terms; ++i)
+			out += " + c" + std::to_string(col(rng));
+		out += " > " + std::to_string(lit(rng)) + ";\n";
+	}
+	return out;
+}
+
+// generated migration scripts: banners, commented-out statements, indentation
+static std::string comment_corpus(std::size_t rows)
+{
+	std::mt19937 rng(20240301);
+	std::uniform_int_distribution<int> pick(0, 3), width(10, 120);
+	std::string out;
+	for (std::size_t r = 0; r < rows; ++r)
+	{
+		switch (pick(rng))
+		{
+		case 0:
+			out += "/*" + std::string(width(rng), '*') + "\n * migration step " + std::to_string(r) + "\n " +
+				std::string(width(rng), '*') + "*/\n";
+			break;
+		case 1:
+			out += "-- " + std::string(width(rng), '-') + "\n";
+			break;
+		case 2:
+			out += "# ALTER TABLE t" + std::to_string(r) + " ADD COLUMN c INT; -- disabled\n";
+			break;
+		default:
+			out += std::string(width(rng) / 10, '\t') + "DELETE FROM t" + std::to_string(r) + " WHERE c = " +
+				std::to_string(r) + ";\n" + std::string(width(rng), ' ') + "\n";
+			break;
+		}
+	}
+	return out;
+}
+
+// a dump: many extended INSERTs of 100 rows mixing numbers and strings
+static std::string dump_corpus(std::size_t rows)
+{
+	std::mt19937 rng(20240304);
+	std::uniform_int_distribution<int> len(4, 40), letter('a', 'z');
+	std::string out;
+	for (std::size_t r = 0; r < rows; ++r)
+	{
+		out += r % 100 ? ",(" : "INSERT INTO `t` VALUES (";
+		out += std::to_string(r) + ",'";
+		for (int i = 0, n = len(rng); i < n; ++i)
+			out += static_cast<char>(letter(rng));
+		out += "'," + std::to_string(rng() % 100000) + "." + std::to_string(rng() % 100) + ")";
+		if (r % 100 == 99 || r + 1 == rows)
+			out += ";\n";
+	}
+	return out;
+}
+
+struct measure
+{
+	std::size_t tokens = 0;
+	std::size_t statements = 0;
+	std::size_t allocs = 0;
+	std::size_t nodes = 0;		// AST nodes placed in statement arenas
+	std::size_t heap_peak = 0;
+	std::size_t rss_kb = 0;
+	double secs = 0;
+};
+
+static bool json = false;
+
+class phase_timer
+{
+	std::size_t allocs, live;
+	std::chrono::steady_clock::time_point start;
+public:
+	phase_timer()
+	{
+		allocs = alloc_count;
+		live = heap_live;
+		heap_peak = live;
+		start = std::chrono::steady_clock::now();
+	}
+
+	void stop(measure& m)
+	{
+		std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+		m.secs = secs.count();
+		m.allocs = alloc_count - allocs;
+		m.heap_peak = heap_peak - live;
+		m.rss_kb = peak_rss_kb();
+	}
+};
+
+static void report(const char* corpus, const char* phase, std::size_t bytes, const measure& m)
+{
+	double per = m.statements ? double(m.allocs) / m.statements : 0;
+	double nodes = m.statements ? double(m.nodes) / m.statements : 0;
+	if (json)
+		printf("{\"corpus\":\"%s\",\"phase\":\"%s\",\"bytes\":%zu,\"tokens\":%zu,\"statements\":%zu,"
+			"\"seconds\":%.6f,\"tokens_per_sec\":%.0f,\"statements_per_sec\":%.0f,\"mb_per_sec\":%.2f,"
+			"\"allocs\":%zu,\"allocs_per_statement\":%.2f,\"nodes_per_statement\":%.2f,"
+			"\"heap_peak_bytes\":%zu,\"peak_rss_kb\":%zu}\n",
+			corpus, phase, bytes, m.tokens, m.statements, m.secs, m.tokens / m.secs, m.statements / m.secs,
+			bytes / m.secs / 1e6, m.allocs, per, nodes, m.heap_peak, m.rss_kb);
+	else
+		printf("%-12s %-8s %10.0f tokens/s %9.0f stmts/s %7.1f MB/s %9.2f allocs/stmt %9.2f nodes/stmt %8zu KB heap %8zu KB rss\n",
+			corpus, phase, m.tokens / m.secs, m.statements / m.secs, bytes / m.secs / 1e6, per, nodes,
+			m.heap_peak / 1024, m.rss_kb);
+}
+
+static bool is_semicolon(const token& t)
+{
+	return t.token_kind == symbol && t.symbol_mark == semicolon_mark;
+}
+
+// the scanner alone, pulling one token at a time; then the same into a
+// token_buffer; then Parser over that buffer, so parsing is timed without lexing;
+// with create, once more with that table in the catalog (INSERT into columns)
+static void run(const char* name, std::string corpus, bool parse, const char* create = nullptr)
+{
+	std::size_t bytes = corpus.size();
+	{
+		Scanner scanner(llvm::make_unique<string_source>(corpus));
+		measure m;
+		phase_timer t;
+		for (token tok = scanner.gettok(); tok.token_kind != eof; tok = scanner.gettok())
+		{
+			++m.tokens;
+			m.statements += is_semicolon(tok);
+		}
+		t.stop(m);
+		report(name, "scan", bytes, m);
+	}
+
+	Scanner batch(llvm::make_unique<string_source>(std::move(corpus)));
+	token_buffer buf;
+	measure fill;
+	phase_timer t;
+	buf.fill_all(batch);
+	t.stop(fill);
+	fill.tokens = buf.size();
+	for (std::size_t i = 0; i < buf.size(); ++i)
+		fill.statements += buf.kinds[i] == symbol && buf.payload[i] == semicolon_mark;
+	report(name, "fill", bytes, fill);
+
+	if (!parse)
+		return;
+	measure m;
+	m.tokens = buf.size();
+	Parser parser(buf);
+	phase_timer p;
+	parser.init();
+	while (auto stmt = parser.ParseStatementAST())
+	{
+		++m.statements;
+		m.nodes += stmt->arena ? stmt->arena->allocations() : 0;
+	}
+	p.stop(m);
+	report(name, "parse", bytes, m);
+
+	if (!create)
+		return;
+	schema_catalog catalog;
+	{
+		Scanner scanner(llvm::make_unique<memory_source>(create, create + strlen(create)));
+		Parser parser(scanner);
+		parser.init();
+		catalog.apply(*parser.ParseStatementAST());
+	}
+	measure b;
+	b.tokens = buf.size();
+	Parser bulk(buf);
+	bulk.set_catalog(&catalog);
+	phase_timer q;
+	bulk.init();
+	while (auto stmt = bulk.ParseStatementAST())
+	{
+		++b.statements;
+		b.nodes += stmt->arena ? stmt->arena->allocations() : 0;
+	}
+	q.stop(b);
+	report(name, "bulk", bytes, b);
+}
+
+// lex_parallel alone; with create, the script behind that CREATE TABLE (and
+// without backquotes) lexed and parsed by one thread, then by script_loader
+static void run_parallel(const char* name, const std::string& corpus, unsigned threads, const char* create = nullptr)
+{
+	const char* begin = corpus.data();
+	const char* end = begin + corpus.size();
+
+	thread_pool pool(threads);
+	token_buffer all;
+	measure m;
+	phase_timer t;
+	lex_parallel(begin, end, all, pool);
+	t.stop(m);
+	m.tokens = all.size();
+	for (std::size_t i = 0; i < all.size(); ++i)
+		m.statements += all.kinds[i] == symbol && all.payload[i] == semicolon_mark;
+	report(name, "parallel", corpus.size(), m);
+	if (!create)
+		return;
+
+	// the parser does not take `quoted` names yet
+	std::string script = std::string(create) + ";\n";
+	for (std::size_t at = 0, q; at < corpus.size(); at = q + 1)
+	{
+		q = corpus.find('`', at);
+		if (q == std::string::npos)
+			q = corpus.size();
+		script.append(corpus, at, q - at);
+	}
+	{
+		schema_catalog catalog;
+		measure s;
+		s.tokens = m.tokens;
+		phase_timer p;
+		Scanner scanner(llvm::make_unique<memory_source>(script.data(), script.data() + script.size()));
+		Parser parser(scanner);
+		parser.set_catalog(&catalog);
+		parser.init();
+		while (auto stmt = parser.ParseStatementAST())
+		{
+			catalog.apply(*stmt);
+			++s.statements;
+			s.nodes += stmt->arena ? stmt->arena->allocations() : 0;
+		}
+		p.stop(s);
+		report(name, "serial", script.size(), s);
+	}
+	{
+		schema_catalog catalog;
+		script_loader loader(pool, &catalog);
+		measure l;
+		l.tokens = m.tokens;
+		phase_timer p;
+		loader.run(script.data(), script.data() + script.size(), [&](script_loader::statement& st)
+		{
+			++l.statements;
+			l.nodes += st.ast && st.ast->arena ? st.ast->arena->allocations() : 0;
+		});
+		p.stop(l);
+		report(name, "loader", script.size(), l);
+	}
+}
+
+// one-row INSERTs as an application issues them: lexed and parsed for every
+// row; prepared once with only the binding done per row; and as text again,
+// through statement_cache, which lexes every row but parses the shape once
+static void run_prepared(std::size_t rows)
+{
+	char sql[128], name[32];
+	std::size_t bytes = 0, shape = 0;
+	{
+		int n = snprintf(sql, sizeof sql, "INSERT INTO t VALUES (0, 'name0', 0.5)");
+		Scanner scanner(llvm::make_unique<memory_source>(sql, sql + n));
+		for (token tok = scanner.gettok(); tok.token_kind != eof; tok = scanner.gettok())
+			++shape;
+	}
+
+	measure parsed;
+	phase_timer t;
+	for (std::size_t r = 0; r < rows; ++r)
+	{
+		int n = snprintf(sql, sizeof sql, "INSERT INTO t VALUES (%zu, 'name%zu', %zu.5)", r, r % 1000, r % 977);
+		bytes += n;
+		Scanner scanner(llvm::make_unique<memory_source>(sql, sql + n));
+		Parser parser(scanner);
+		parser.init();
+		auto stmt = parser.ParseStatementAST();
+		parsed.statements += stmt != nullptr;
+		parsed.nodes += stmt && stmt->arena ? stmt->arena->allocations() : 0;
+	}
+	t.stop(parsed);
+	parsed.tokens = shape * rows;
+	report("one_row", "parse", bytes, parsed);
+
+	measure bound;
+	phase_timer p;
+	prepared_statement insert("INSERT INTO t VALUES (?, ?, ?)");
+	for (std::size_t r = 0; r < rows; ++r)
+	{
+		int n = snprintf(name, sizeof name, "name%zu", r % 1000);
+		insert.bind_int(0, r);
+		insert.bind_string(1, llvm::StringRef(name, n));
+		insert.bind_double(2, r % 977 + 0.5);
+		bound.statements += insert.execute().ast != nullptr;
+	}
+	p.stop(bound);
+	bound.tokens = shape * rows;
+	bound.nodes = insert.statement().arena->allocations();
+	report("one_row", "prepared", bytes, bound);
+
+	measure cached;
+	statement_cache cache;
+	phase_timer c;
+	for (std::size_t r = 0; r < rows; ++r)
+	{
+		int n = snprintf(sql, sizeof sql, "INSERT INTO t VALUES (%zu, 'name%zu', %zu.5)", r, r % 1000, r % 977);
+		Scanner scanner(llvm::make_unique<memory_source>(sql, sql + n));
+		cached.statements += cache.next(scanner).ast != nullptr;
+	}
+	c.stop(cached);
+	cached.tokens = shape * rows;
+	report("one_row", "cached", bytes, cached);
+	if (!json)
+		printf("statement cache: %zu hits, %zu misses, %zu parsed as written\n", cache.hits, cache.misses, cache.uncached);
+}
+
+// lines as the YSQL> shell appends them: a string typed over two lines, with
+// or without a ';' in it, is one statement that runs once it is closed; what
+// ran is dropped as the shell does
+static bool check_shell_lines()
+{
+	static const char* const typed[][2] = {
+		{ "INSERT INTO t VALUES ('ab\n", "cd');\n" },
+		{ "INSERT INTO t VALUES ('a;b\n", "c');\n" },
+		{ "INSERT INTO t VALUES ('a;b -- still open\n", "c');\n" },
+	};
+	for (auto& lines : typed)
+	{
+		incremental_script script;
+		std::size_t runs = 0, errors = 0;
+		bool pending = false;
+		for (const char* line : lines)
+		{
+			script.append(line);
+			pending = script.take_complete([&](const incremental_script::statement& s)
+			{
+				runs += s.ast != nullptr;
+				errors += !s.error.empty();
+			});
+			script.drop_taken();
+		}
+		if (runs != 1 || errors || pending)
+		{
+			fprintf(stderr, "shell lines %s%s: %zu run, %zu errors%s\n", lines[0], lines[1], runs, errors,
+				pending ? ", still pending" : "");
+			return false;
+		}
+	}
+
+	// a long session keeps only what is pending, and still counts lines from its start
+	incremental_script script;
+	for (int i = 0; i < 1000; ++i)
+	{
+		script.append("SELECT a FROM t;\n");
+		script.take_complete([](const incremental_script::statement&) {});
+		script.drop_taken();
+	}
+	std::string error;
+	script.append("SELECT a\nFROM ;\n");
+	script.take_complete([&](const incremental_script::statement& s) { error = s.error; });
+	script.drop_taken();
+	if (error.find("line 1002, column 6") == std::string::npos || !script.statements().empty() ||
+		script.text().size() > 1)
+	{
+		fprintf(stderr, "long shell session: %zu statements, %zu bytes kept, error \"%s\"\n",
+			script.statements().size(), script.text().size(), error.c_str());
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && strcmp(argv[1], "--json") == 0)
+	{
+		json = true;
+		--argc;
+		++argv;
+	}
+	std::size_t rows = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200000;
+	unsigned threads = argc > 2 ? static_cast<unsigned>(strtoul(argv[2], nullptr, 10)) : 0;
+	if (!check_shell_lines())
+		return 1;
+	if (!json)
+		printf("scan kernels: %s, %zu rows\n", select_scan_kernels().name, rows);
+	run("numeric", numeric_corpus(rows), true,
+		"CREATE TABLE t (c0 DOUBLE, c1 DOUBLE, c2 DOUBLE, c3 DOUBLE, c4 DOUBLE, c5 DOUBLE, c6 DOUBLE, c7 DOUBLE)");
+	run("strings", string_corpus(rows), true,
+		"CREATE TABLE t (c0 CHAR(255), c1 CHAR(255), c2 CHAR(255), c3 CHAR(255), c4 CHAR(255), c5 CHAR(255))");
+	run("identifiers", identifier_corpus(rows), true);
+	run("nested_where", nested_where_corpus(rows), true);
+	run("wide_where", wide_where_corpus(rows), true);
+	run("comments", comment_corpus(rows), true);
+	// MySQL-only operators and c[i] subscripts, which the parser does not take
+	run("operators", operator_corpus(rows), false);
+	run_prepared(rows);
+	run_parallel("dump", dump_corpus(rows * 5), threads, "CREATE TABLE t (id INT, label CHAR(40), price DOUBLE)");
+	return 0;
+}
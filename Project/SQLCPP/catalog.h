@@ -17,12 +17,14 @@
 #include "llvm/IR/Verifier.h"
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include<exception>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include<exception>
 #include"llvmsql.h"
@@ -61,6 +63,71 @@ public:
 	const int T = literal_string;
 };
 
+/// column_def - one column as CREATE TABLE declared it
+class column_def
+{
+public:
+	atom name = no_atom;
+	int dtype = blank;	// literal_int, literal_double or literal_string, as ColdefAST
+	int width = 0;		// CHAR(n)
+};
+
+class table_schema
+{
+public:
+	atom name = no_atom;
+	std::vector<column_def> cols;
+
+	// the table stmt creates; false for any other statement, and for a
+	// CREATE TABLE with a column type the parser does not know yet (out.name
+	// is set then)
+	static bool declared_by(const StatementAST& stmt, table_schema& out);
+
+	// index in cols, -1 if there is no such column
+	int column(atom col) const
+	{
+		for (std::size_t i = 0; i < cols.size(); ++i)
+			if (cols[i].name == col)
+				return static_cast<int>(i);
+		return -1;
+	}
+};
+
+/// schema_catalog - the tables the session has created
+/// Parser::set_catalog() lets INSERT put literal rows straight into typed
+/// columns of a table found here.
+class schema_catalog
+{
+public:
+	// CREATE TABLE adds (or replaces) its table, other statements are ignored
+	void apply(const StatementAST& stmt);
+	void add(table_schema table)
+	{
+		atom name = table.name;
+		tables[name] = std::move(table);
+		++changes;
+	}
+	bool drop(atom table)
+	{
+		if (!tables.erase(table))
+			return false;
+		++changes;
+		return true;
+	}
+	// goes up with every add and drop, for whoever keeps what was parsed against it
+	std::uint64_t version() const { return changes; }
+
+	const table_schema* find(atom table) const
+	{
+		auto found = tables.find(table);
+		return found == tables.end() ? nullptr : &found->second;
+	}
+
+private:
+	std::unordered_map<atom, table_schema> tables;
+	std::uint64_t changes = 0;
+};
+
 
 
 
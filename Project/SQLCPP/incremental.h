@@ -0,0 +1,84 @@
+#pragma once
+
+#ifndef llvmsql_incremental
+#define llvmsql_incremental
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "llvm/ADT/StringRef.h"
+#include"llvmsql.h"
+
+/// incremental_script - a script that is edited in place, for the YSQL> shell
+/// and editors.
+///
+/// The text, its tokens and one entry per statement are kept between edits.
+/// An edit re-lexes from a little before the changed bytes until the scanner
+/// lands on the start of a token it had produced before, shifted by the size
+/// change; from there on the old tokens are kept, since the scanner carries
+/// no state from one token to the next.  Statements whose tokens were not
+/// touched keep their AST, only the others are parsed again.
+///
+/// Scanning is always in recover mode, so a half-typed string becomes a
+/// lex_error statement instead of an exception.  A lex_error is a string or
+/// comment that found no end before the end of the text, whatever the
+/// scanner made of the bytes after its ';', so that statement is not
+/// complete: the next line may close it.
+class incremental_script
+{
+public:
+	struct statement
+	{
+		std::size_t first = 0;		// token index
+		std::size_t count = 0;		// tokens, with the ';' (or lex_error) that ends it
+		bool complete = false;		// ended by ';', not by a lex_error or the end of the text
+		bool reused = false;		// AST kept from before the last edit
+		std::unique_ptr<StatementAST> ast;
+		std::string error;			// lexical or syntax error, ast is null then
+	};
+
+	explicit incremental_script(std::string text = std::string());
+
+	// replace removed bytes at offset at with inserted
+	void edit(std::size_t at, std::size_t removed, llvm::StringRef inserted);
+	void append(llvm::StringRef more) { edit(source.size(), 0, more); }
+
+	const std::string& text() const { return source; }
+	const token_buffer& tokens() const { return toks; }
+	const std::vector<statement>& statements() const { return stmts; }
+
+	// run(s) for each complete statement not handed out before, in order;
+	// true if an incomplete one is left.  Statements are told apart by where
+	// they start, since an edit may renumber them: for a script that is only
+	// appended to, like the YSQL> shell's
+	bool take_complete(const std::function<void(const statement&)>& run);
+	// forget the statements take_complete handed out, with their tokens and
+	// text, so a long session holds only what is still being typed; errors
+	// are still located by their line since the first byte appended
+	void drop_taken();
+
+	// work done by the last edit
+	std::size_t relexed_tokens = 0;
+	std::size_t reparsed_statements = 0;
+	std::size_t reused_statements = 0;
+
+private:
+	std::string source;
+	token_buffer toks;
+	std::vector<statement> stmts;
+	std::uint64_t taken_to = 0;		// statements starting before this were handed out
+	// what drop_taken cut off the front: bytes, newlines, and where the line
+	// holding the first byte kept starts, counted from the first byte ever
+	std::uint64_t dropped_bytes = 0;
+	std::uint64_t dropped_lines = 0;
+	std::uint64_t line_start = 0;
+
+	std::string where(std::uint64_t at) const;
+	void rebuild();
+	void parse(statement& s);
+};
+
+#endif
@@ -0,0 +1,26 @@
+#pragma once
+
+#ifndef llvmsql_intern
+#define llvmsql_intern
+
+#include <cstddef>
+#include <cstdint>
+#include "llvm/ADT/StringRef.h"
+
+/// atom - an interned identifier
+/// Equal spellings always get the same atom, so names are compared and
+/// hashed as 32-bit integers.  Atoms live for the whole process and are
+/// shared by every thread; 0 is never handed out and means "no name".
+using atom = std::uint32_t;
+
+constexpr atom no_atom = 0;
+
+// thread-safe; the spelling is copied, case is kept as written
+atom intern(llvm::StringRef s);
+
+// the spelling of an atom, valid for the life of the process
+llvm::StringRef atom_text(atom a);
+
+std::size_t atom_count();
+
+#endif
@@ -4,7 +4,10 @@
 #define llvmsql_h
 
 #include "llvm/ADT/APFloat.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
 #include "llvm/IR/BasicBlock.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DerivedTypes.h"
@@ -16,15 +19,19 @@
 #include "llvm/IR/Verifier.h"
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include<exception>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include<exception>
-#define LL_LRLen 6
+#include"ast_arena.h"
+#include"intern.h"
 
 enum reserved_token_value
 {
@@ -714,203 +721,185 @@ enum status
 	literal_string,
 	literal_int,
 	literal_double,
+	literal_bigint,
 	id,
 	symbol,
-	eof
+	eof,
+	lex_error	// recover mode only: the bad bytes up to and including the next ';'
 };
 
-struct val;
-class value;
-
-class int_value;
-
-class double_value;
-
-class string_value;
-
-class reserved_value;
-
-class id_value;
-
-class eof_value;
-
-class token;
-
-class value
+/// token - what gettok() hands to the parser
+/// Trivially copyable, 24 bytes.  offset is where the token starts in the
+/// input; Scanner::locate() turns it into a line and column when a message
+/// needs one.  An id carries its interned atom.  The text
+/// of a string literal is a span into the scanner's input window (or its
+/// escape-decoding buffer) and stays valid until the next gettok(); copy it
+/// out if it must live longer.
+class token
 {
-	friend val;
 public:
-	virtual ~value() = default;
+	int token_kind = eof;		// enum status
+	std::uint32_t length = 0;	// id / literal_string: bytes of text
+	std::uint64_t offset = 0;
+	union
+	{
+		int symbol_mark;			// symbol: reserved_token_value
+		std::int64_t int_literal;	// literal_int / literal_bigint
+		double double_literal;		// literal_double
+		const char* text;			// literal_string, lex_error
+		atom name;					// id
+	};
+
+	token() :int_literal(0) {}
+	llvm::StringRef str() const { return token_kind == id ? atom_text(name) : llvm::StringRef(text, length); }
 };
 
-class blank_value :public value
-{
-	friend val;
-	char ch = ' ';
-public:
-	blank_value(char ch):ch(ch){}
-};
+static_assert(std::is_trivially_copyable<token>::value, "token is copied around by value");
 
-class int_value :public value
-{
-	friend val;
-	int i;
-public:
-	int_value(int i) :i(i) {}
-};
+class scan_source;
+struct scan_kernels;
+struct source_location;
 
-class double_value :public value
+/// Scanner - all lexing state for one input
+/// Independent instances can run on different threads or sessions; the free
+/// gettok()/set_source()/init_scanner() work on a per-thread default one.
+class Scanner
 {
-	friend val;
-	double d;
+	std::unique_ptr<scan_source> source;
+	const scan_kernels& kernels;
+	std::string string_literal;	// escape-decoded text of the last string literal
+	int scanner_status = blank;
+	bool recover = false;
+	std::size_t errors = 0;
+	std::uint64_t comment_at = 0;		// where the block comment being skipped starts
+
+	int peek(std::size_t k);
+	void scroll_Char(std::size_t n = 1);
+	void skip_blank();
+	void skip_line();
+	bool skip_block_comment();
+	token resync(const char* from);
+	token scan();
+	std::string where(std::uint64_t at);
 public:
-	double_value(double d) :d(d) {}
+	Scanner();
+	explicit Scanner(std::unique_ptr<scan_source> src);
+	~Scanner();
+	Scanner(const Scanner&) = delete;
+	Scanner& operator=(const Scanner&) = delete;
+
+	void set_source(std::unique_ptr<scan_source> src);
+	bool has_source() const { return source != nullptr; }
+	token gettok();
+
+	// recover mode: unterminated strings and comments come back as lex_error
+	// tokens instead of throwing, and scanning resumes after the next ';'
+	void set_recover(bool on) { recover = on; }
+	std::size_t error_count() const { return errors; }
+
+	// line and column of a token offset, or 0/0 once the source dropped it
+	source_location locate(std::uint64_t offset);
 };
 
-class string_value :public value
-{
-	friend val;
-	std::string s;
-public:
-	string_value(std::string s) :s(s) {}
-};
+// what went wrong in a lex_error token
+const char* lex_error_reason(const token& t);
 
-class reserved_value :public value
+/// token_buffer - a statement or a whole script tokenized up front
+/// Structure of arrays, so the parser walks the dense kinds[] and only loads
+/// lengths[]/payload[] for the tokens it actually uses.  Ids are atoms; the
+/// text of string literals is copied into one pool, which keeps every token
+/// valid for the life of the buffer and makes lookahead unbounded.  Tokens
+/// returned by at() point into the pool: push() and fill_*() may move it.
+class token_buffer
 {
-	friend val;
-	int r;
 public:
-	reserved_value(int r) :r(r) {}
+	std::vector<std::uint8_t> kinds;		// enum status
+	std::vector<std::uint32_t> lengths;		// id / literal_string / lex_error: bytes of text
+	std::vector<std::int64_t> payload;		// symbol_mark, int_literal, double bits, atom or offset into text
+	std::vector<std::uint64_t> offsets;		// token::offset
+	std::string text;
+
+	std::size_t size() const { return kinds.size(); }
+	void clear();
+	void push(const token& t);
+	// an eof token past the end
+	token at(std::size_t i) const;
+
+	// up to and including the next ';' (or lex_error), returns the number of tokens added
+	std::size_t fill_statement(Scanner& scanner);
+	std::size_t fill_all(Scanner& scanner);
 };
 
-class id_value :public value
-{
-	friend val;
-	std::string id;
-public:
-	id_value(std::string id) :id(id) {}
-};
+Scanner& default_scanner();
+token gettok();
+int reserved_lookup(const char* s, std::size_t n);
 
-class eof_value :public value
-{
-	const int v = 0;
-};
 
-struct val
-{
-	std::string string_literal; // ' ""
-	int int_literal = 0;    // жǷ int
-	double double_literal = 0.; // жǷ double
-	int symbol_mark = 0;
-	std::string IdentifierStr;
-	char ch = ' ';
-	val() = default;
-	val(eof_value ev):ch(EOF){}
-	val& operator=(const string_value& s)
-	{
-		string_literal = s.s;
-		return *this;
-	}
-	val& operator=(const int_value& i)
-	{
-		int_literal = i.i;
-		return *this;
-	}
-	val& operator=(const double_value& d)
-	{
-		double_literal = d.d;
-		return *this;
-	}
-	val& operator=(const reserved_value& r)
-	{
-		symbol_mark = r.r;
-		return *this;
-	}
-	val& operator=(const id_value& i)
-	{
-		IdentifierStr = i.id;
-		return *this;
-	}
-	val& operator=(const blank_value& blank)
-	{
-		ch = blank.ch;
-		return *this;
-	}
-};
 
-class token
+
+
+// name_entity_map key, compared and hashed by atom
+class table_col
 {
 public:
-	int token_kind;
-	val token_value;
+	atom table_name = no_atom;
+	atom col_name = no_atom;
+	table_col() = default;
+	table_col(atom table_name, atom col_name) :table_name(table_name), col_name(col_name) {}
 
-	token() = default;
-	token(const token& a) :token_kind(a.token_kind), token_value(a.token_value) {}
-	token& operator=(const token& b)
+	bool operator==(const table_col& r) const { return table_name == r.table_name && col_name == r.col_name; }
+	bool operator<(const table_col& r) const
 	{
-		token_kind = b.token_kind;
-		token_value = b.token_value;
-		return *this;
+		return table_name != r.table_name ? table_name < r.table_name : col_name < r.col_name;
 	}
-	
 };
 
-token gettok();
-
-
-
-
-
-class table_col :public val
+namespace std
 {
-	using pair = std::pair<std::string, std::string>;
-	pair p;
-public:
-	typename pair::first_type& table_name = p.first;
-	typename pair::second_type& col_name = p.second;
-	table_col() = default;
-	table_col(const std::string& table_name, const std::string& col_name) :p(table_name, col_name) {}
-};
+	template<>
+	struct hash<table_col>
+	{
+		std::size_t operator()(const table_col& k) const
+		{
+			return (static_cast<std::size_t>(k.table_name) << 32 | k.col_name) * 0x9E3779B97F4A7C15ull >> 16;
+		}
+	};
+}
 
 class ExprAST;
-class ExpAST;
-class BooleanPrimaryAST;
-class PredicateAST;
-class BitExprAST;
-class BitExpAST;
-class BitExAST;
-class SimpleExprAST;
-class LiteralAST;
 class StringLiteralAST;
 class IntLiteralAST;
 class DoubleLiteralAST;
-class ParenExprAST;
 class TablecolAST;
 class IdAST;
 class CallAST;
 class ExistsSubqueryAST;
 class SubqueryAST;
 class SelectExprAST;
+class TableRefsAST;
+class TableRefAST;
 
 class CreateTableSimpleAST;
 class ColdefAST;
 class OnJoinCondAST;
 class UsingJoinCondAST;
+class StatementAST;
+class InsertAST;
+class DeleteAST;
+class PrepareAST;
+class ExecuteAST;
+class DeallocateAST;
+class insert_column;
+class schema_catalog;
 
 std::unique_ptr<ExprAST> ParseExprAST();
-std::unique_ptr<ExpAST> ParseExpAST();
-std::unique_ptr<BooleanPrimaryAST> ParseBPAST();
-std::unique_ptr<PredicateAST> ParsePredicateAST();
-std::unique_ptr<BitExprAST> ParseBitExprAST();
-std::unique_ptr<BitExpAST> ParseBitExpAST();
-std::unique_ptr<BitExAST> ParseBitExAST();
-std::unique_ptr<SimpleExprAST> ParseSEAST();
-std::unique_ptr<LiteralAST> ParseLiteralAST();
+std::unique_ptr<ExprAST> ParseSEAST();
+std::unique_ptr<ExprAST> ParseLiteralAST();
 std::unique_ptr<StringLiteralAST> ParseStringLiteralAST();
 std::unique_ptr<IntLiteralAST> ParseIntLiteralAST();
 std::unique_ptr<DoubleLiteralAST> ParseDoubleLiteralAST();
 std::unique_ptr<TablecolAST> ParseTablecolAST();
-std::unique_ptr<ParenExprAST> ParseParenExprAST();
+std::unique_ptr<ExprAST> ParseParenExprAST();
 std::unique_ptr<IdAST> ParseIdAST();
 std::unique_ptr<CallAST> ParseCallAST();
 std::unique_ptr<ExistsSubqueryAST> ParseExistsSubqueryAST();
@@ -919,201 +908,291 @@ std::unique_ptr<CreateTableSimpleAST> ParseCreateTableSimpleAST();
 std::unique_ptr<ColdefAST> ParseColdefAST();
 std::unique_ptr<OnJoinCondAST> ParseOnJoinCondAST();
 std::unique_ptr<UsingJoinCondAST> ParseUsingJoinCondAST();
+std::unique_ptr<StatementAST> ParseStatementAST();
+std::unique_ptr<InsertAST> ParseInsertAST();
+std::unique_ptr<DeleteAST> ParseDeleteAST();
 
-
-
-
-
-class ExprAST
+/// syntax_error - what the Parser throws; offset is the token it stopped at
+/// what() has the place appended to reason
+class syntax_error :public std::runtime_error
 {
 public:
-	std::unique_ptr<ExpAST> lhs;
-	int op;
-	std::unique_ptr<ExprAST> rhs;
-	virtual ~ExprAST() = default;
-	ExprAST() = default;
-	ExprAST(std::unique_ptr<ExpAST> lhs, int op, std::unique_ptr<ExprAST> rhs):
-		lhs(std::move(lhs)),op(op) ,rhs(std::move(rhs)){}
+	std::string reason;
+	std::uint64_t offset;
+	syntax_error(const std::string& reason, std::uint64_t offset, const std::string& where) :
+		std::runtime_error(reason + where), reason(reason), offset(offset) {}
 };
 
-class ExpAST :public ExprAST
+/// Parser - recursive descent with a token cursor
+/// Either parses a token_buffer filled up front, or pulls tokens from a
+/// Scanner on demand into a buffer of its own, so lookahead(k) works in both
+/// modes.  currtoken is always the token at the cursor.
+class Parser
 {
-public:
-	std::unique_ptr<ExprAST> expr;
-	std::unique_ptr<BooleanPrimaryAST> bp;
-	ExpAST() = default;
-	ExpAST(std::unique_ptr<ExprAST> expr, std::unique_ptr<BooleanPrimaryAST> bp) :
-		expr(std::move(expr)),bp(std::move(bp)){}
-};
+	Scanner* scanner = nullptr;
+	token_buffer own;
+	const token_buffer* tokens;
+	std::size_t pos = 0;
+	token currtoken;
+	bool recover = false;
+	std::size_t skipped = 0;
+	std::function<void(const std::string& reason, std::uint64_t offset)> on_skip;
+	std::unique_ptr<ast_arena> arena;
+	unsigned params = 0;		// ? seen so far in this statement
+	const schema_catalog* catalog = nullptr;
+
+	// every node is built in arena, ParseStatementAST passes it on to the statement
+	ast_arena& nodes()
+	{
+		if (!arena)
+			arena = llvm::make_unique<ast_arena>();
+		return *arena;
+	}
+	template<class T, class... Args>
+	std::unique_ptr<T> make(Args&&... args)
+	{
+		return std::unique_ptr<T>(new (nodes()) T(std::forward<Args>(args)...));
+	}
 
-class BooleanPrimaryAST :public ExpAST
-{
+	void next();
+	bool is_symbol(int mark) const { return currtoken.token_kind == symbol && currtoken.symbol_mark == mark; }
+	void expect(int mark, const char* what);
+	[[noreturn]] void fail(const char* what);
+	table_col ParseColumnName();
+	// ParseExprAST keeps its operands and pending operators on these instead of
+	// the native stack; a nested call works above what it found there
+	struct pending_op
+	{
+		int op;				// symbol_mark, left_bracket_mark for an open '('
+		std::uint8_t prec;
+		bool prefix;
+		bool negated;		// NOT LIKE, NOT REGEXP
+	};
+	std::vector<std::unique_ptr<ExprAST>> operand_stack;
+	std::vector<pending_op> op_stack;
+	// literals of an IN list before they go to the arena
+	std::vector<std::int64_t> in_ints;
+	std::vector<double> in_doubles;
+	std::vector<llvm::StringRef> in_strings;
+
+	void reduce();
+	std::unique_ptr<ExprAST> ParseInAST(std::unique_ptr<ExprAST> lhs, bool negated);
+	bool ParseInsertLiteral(insert_column& col);
+	std::unique_ptr<StatementAST> ParseOneStatementAST();
 public:
-	std::unique_ptr<BooleanPrimaryAST> bp;
-	std::unique_ptr<PredicateAST> p;
-	int flag;
-	int op;
-	std::unique_ptr<SubqueryAST> sub;
-	BooleanPrimaryAST() = default;
-	BooleanPrimaryAST(std::unique_ptr<BooleanPrimaryAST> bp, std::unique_ptr<PredicateAST> p, 
-		int flag, int op,	std::unique_ptr<SubqueryAST> sub):
-		bp(std::move(bp)),p(std::move(p)),flag(flag),op(op),sub(std::move(sub)) {}
-};
+	explicit Parser(Scanner& scanner) :scanner(&scanner), tokens(&own) {}
+	explicit Parser(const token_buffer& tokens) :tokens(&tokens) {}
 
-class PredicateAST :public BooleanPrimaryAST
-{
-public:
-	std::unique_ptr<BitExprAST> bitexpr;
-	bool flag;
-	std::unique_ptr<BitExprAST> rhs;
-	std::unique_ptr<SubqueryAST> sub;
-	std::vector<std::unique_ptr<ExprAST>> exprs;
-	PredicateAST() = default;
-	PredicateAST(std::unique_ptr<BitExprAST> bitexpr, bool flag, 
-		std::unique_ptr<BitExprAST> rhs, std::unique_ptr<SubqueryAST> sub,std::vector<std::unique_ptr<ExprAST>> exprs) :
-			bitexpr(std::move(bitexpr)),flag(flag),rhs(std::move(rhs)),sub(std::move(sub)),exprs(std::move(exprs)){}
+	// from: buffer mode only, the token to start at
+	void init(std::size_t from = 0);
+	token lookahead(std::size_t k);
+
+	// recover mode: a statement that holds a lex_error or fails to parse is
+	// skipped up to its ';' and counted, and ParseStatementAST goes on with the next;
+	// skip, if given, is told why and at which offset of the error
+	void set_recover(bool on, std::function<void(const std::string& reason, std::uint64_t offset)> skip = nullptr)
+	{
+		recover = on;
+		on_skip = std::move(skip);
+	}
+	std::size_t skipped_statements() const { return skipped; }
+
+	// INSERT into a table found here keeps its literals in typed columns;
+	// the catalog must outlive the parser
+	void set_catalog(const schema_catalog* tables) { catalog = tables; }
+
+	// nodes from the other Parse* entries stay in the parser's arena, which
+	// ParseStatementAST leaves alone, until this hands it over; it must outlive them
+	std::unique_ptr<ast_arena> take_arena() { return std::move(arena); }
+
+	std::unique_ptr<ExprAST> ParseExprAST();
+	std::unique_ptr<ExprAST> ParseSEAST();
+	std::unique_ptr<ExprAST> ParseLiteralAST();
+	std::unique_ptr<StringLiteralAST> ParseStringLiteralAST();
+	std::unique_ptr<IntLiteralAST> ParseIntLiteralAST();
+	std::unique_ptr<DoubleLiteralAST> ParseDoubleLiteralAST();
+	std::unique_ptr<TablecolAST> ParseTablecolAST();
+	std::unique_ptr<ExprAST> ParseParenExprAST();
+	std::unique_ptr<IdAST> ParseIdAST();
+	std::unique_ptr<CallAST> ParseCallAST();
+	std::unique_ptr<CallAST> ParseCallAST(atom callee);
+	std::unique_ptr<ExistsSubqueryAST> ParseExistsSubqueryAST();
+	std::unique_ptr<SubqueryAST> ParseSubqueryAST();
+	std::unique_ptr<CreateTableSimpleAST> ParseCreateTableSimpleAST();
+	std::unique_ptr<ColdefAST> ParseColdefAST();
+	std::unique_ptr<OnJoinCondAST> ParseOnJoinCondAST();
+	std::unique_ptr<UsingJoinCondAST> ParseUsingJoinCondAST();
+	std::unique_ptr<SelectExprAST> ParseSelectExprAST();
+	std::unique_ptr<TableRefsAST> ParseTableRefsAST();
+	// one statement up to, not including, its ';'; nullptr at the end of input
+	std::unique_ptr<StatementAST> ParseStatementAST();
+	std::unique_ptr<InsertAST> ParseInsertAST();
+	std::unique_ptr<DeleteAST> ParseDeleteAST();
+	std::unique_ptr<PrepareAST> ParsePrepareAST();
+	std::unique_ptr<ExecuteAST> ParseExecuteAST();
+	std::unique_ptr<DeallocateAST> ParseDeallocateAST();
 };
 
-class BitExprAST :public PredicateAST
+Parser& default_parser();
+
+
+
+
+
+/// expr_kind - what an ExprAST node is
+/// One node per literal, name and operator; each kind has exactly one class,
+/// so llvm::isa/cast/dyn_cast (classof below) work without RTTI.
+enum expr_kind : std::uint8_t
 {
-public:
-	std::unique_ptr<BitExpAST> bitexp;
-	int op;
-	std::unique_ptr<BitExprAST> bitexpr;
-	BitExprAST() = default;
-	BitExprAST(std::unique_ptr<BitExpAST> bitexp,int op, std::unique_ptr<BitExprAST> bitexpr) :
-		bitexp(std::move(bitexp)),op(op),bitexpr(std::move(bitexpr)){}
+	int_expr,
+	double_expr,
+	string_expr,
+	id_expr,			// column
+	tablecol_expr,		// table.column
+	call_expr,
+	unary_expr,			// - + ~ ! NOT
+	binary_expr,		// arithmetic, comparison, XOR, LIKE, REGEXP
+	logical_expr,		// AND OR, any number of operands
+	is_null_expr,
+	in_list_expr,
+	in_subquery_expr,
+	quantified_expr,	// op ALL|ANY (subquery)
+	exists_expr,
+	subquery_expr,		// (SELECT ...) as a value
+	param_expr			// ? in a prepared statement
 };
 
-class BitExpAST :public BitExprAST
+class ExprAST :public ast_node
 {
 public:
-	std::unique_ptr<BitExpAST> bitexp = nullptr;
-	int op;
-	std::unique_ptr<BitExAST> bitex = nullptr;
-	BitExpAST() = default;
-	BitExpAST(std::unique_ptr<BitExAST> bitex) :
-		bitex(std::move(bitex)) {}
-	BitExpAST(std::unique_ptr<BitExpAST> bitexp, int op, std::unique_ptr<BitExAST> bitex) :
-		bitexp(std::move(bitexp)), op(op), bitex(std::move(bitex)) {}
+	expr_kind kind;
+	explicit ExprAST(expr_kind kind) :kind(kind) {}
+	virtual ~ExprAST() = default;
 };
 
-class BitExAST :public BitExpAST
+class IntLiteralAST final :public ExprAST
 {
 public:
-	int mark;
-	std::unique_ptr<BitExAST> bitex = nullptr;
-	std::unique_ptr<SimpleExprAST> SE = nullptr;
-	BitExAST() = default;
-	BitExAST(int mark, std::unique_ptr<BitExAST> bitex, std::unique_ptr<SimpleExprAST> SE) :
-		mark(mark), bitex(std::move(bitex)), SE(std::move(SE)) {}
+	std::int64_t value;
+	IntLiteralAST(std::int64_t value) :ExprAST(int_expr), value(value) {}
+	static bool classof(const ExprAST* e) { return e->kind == int_expr; }
 };
 
-class SimpleExprAST :public BitExAST
+class DoubleLiteralAST final :public ExprAST
 {
 public:
-	std::unique_ptr<IdAST> id = nullptr;
-	std::unique_ptr<CallAST> call = nullptr;
-	std::unique_ptr<TablecolAST> tablecol = nullptr;
-	std::unique_ptr<ExprAST> expr = nullptr;
-	std::unique_ptr<SubqueryAST> sub = nullptr;
-	std::unique_ptr<ExistsSubqueryAST> exists = nullptr;
-	std::unique_ptr<LiteralAST> lit = nullptr;
-
-	SimpleExprAST() = default;
-	SimpleExprAST(std::unique_ptr<IdAST> id):id(std::move(id)){}
-	SimpleExprAST(std::unique_ptr<CallAST> call) :call(std::move(call)) {}
-	SimpleExprAST(std::unique_ptr<TablecolAST> tablecol) :tablecol(std::move(tablecol)) {}
-	SimpleExprAST(std::unique_ptr<ExprAST> expr) :expr(std::move(expr)) {}
-	SimpleExprAST(std::unique_ptr<SubqueryAST> sub) :sub(std::move(sub)) {}
-	SimpleExprAST(std::unique_ptr<ExistsSubqueryAST> exists) :exists(std::move(exists)) {}
-	SimpleExprAST(std::unique_ptr<LiteralAST> lit) :lit(std::move(lit)) {}
+	double value;
+	DoubleLiteralAST(double value) :ExprAST(double_expr), value(value) {}
+	static bool classof(const ExprAST* e) { return e->kind == double_expr; }
 };
 
-class IdAST final :public SimpleExprAST
+class StringLiteralAST final :public ExprAST
 {
 public:
-	std::unique_ptr<std::string> id=nullptr;
-	IdAST(std::unique_ptr<std::string> id) :id(std::move(id)) {}
+	llvm::StringRef value;	// in the statement's arena
+	StringLiteralAST(llvm::StringRef value) :ExprAST(string_expr), value(value) {}
+	static bool classof(const ExprAST* e) { return e->kind == string_expr; }
 };
 
-class ColdefAST
+class IdAST final :public ExprAST
 {
 public:
-	std::unique_ptr<std::string> col_name = nullptr;
-	int dtype = 0;
-	bool nullable = true;
-	bool unique = false;
-	bool primary = false;
-	int n ;
-	ColdefAST() = default;
-	ColdefAST(std::unique_ptr<std::string> colname, int dtype, bool nullable, bool unique, bool primary) :
-		col_name(std::move(col_name)), dtype(dtype), nullable(nullable), unique(unique), primary(primary) {}
-	ColdefAST(std::unique_ptr<std::string> colname, int dtype, bool nullable, bool unique, bool primary, int n) :
-		col_name(std::move(col_name)), dtype(dtype), nullable(nullable), unique(unique), primary(primary), n(n) {}
+	atom id = no_atom;
+	IdAST(atom id) :ExprAST(id_expr), id(id) {}
+	static bool classof(const ExprAST* e) { return e->kind == id_expr; }
 };
 
-class TablecolAST final :SimpleExprAST
+class TablecolAST final :public ExprAST
 {
 public:
-	std::unique_ptr<std::string> table_name = nullptr;
-	std::unique_ptr<std::string> col_name = nullptr;
-	TablecolAST(std::unique_ptr<std::string> table_name, std::unique_ptr<std::string> col_name):
-		table_name(std::move(table_name)), col_name(std::move(col_name)) {}
+	atom table_name = no_atom;
+	atom col_name = no_atom;
+	TablecolAST(atom table_name, atom col_name) :
+		ExprAST(tablecol_expr), table_name(table_name), col_name(col_name) {}
+	static bool classof(const ExprAST* e) { return e->kind == tablecol_expr; }
 };
 
-class CallAST final :public SimpleExprAST
+class CallAST final :public ExprAST
 {
 public:
-	std::unique_ptr<std::string> callee;
+	atom callee;
 	std::vector<std::unique_ptr<ExprAST>> args;
-	CallAST(std::unique_ptr<std::string> callee, std::vector<std::unique_ptr<ExprAST>> args)
-		: callee(std::move(callee) ), args(std::move(args)) {}
+	CallAST(atom callee, std::vector<std::unique_ptr<ExprAST>> args)
+		: ExprAST(call_expr), callee(callee), args(std::move(args)) {}
+	static bool classof(const ExprAST* e) { return e->kind == call_expr; }
 };
 
-class LiteralAST :public SimpleExprAST
+class UnaryExprAST final :public ExprAST
 {
 public:
-	std::unique_ptr<IntLiteralAST> intvalue = nullptr;
-	std::unique_ptr<DoubleLiteralAST> doublevalue = nullptr;
-	std::unique_ptr<StringLiteralAST> stringvalue = nullptr;
-	LiteralAST() = default;
-	LiteralAST(std::unique_ptr<IntLiteralAST> intvalue):intvalue(std::move(intvalue)){}
-	LiteralAST(std::unique_ptr<DoubleLiteralAST> doublevalue) :doublevalue(std::move(doublevalue)) {}
-	LiteralAST(std::unique_ptr<StringLiteralAST> stringvalue) :stringvalue(std::move(stringvalue)) {}
+	int op;		// symbol_mark
+	std::unique_ptr<ExprAST> operand;
+	UnaryExprAST(int op, std::unique_ptr<ExprAST> operand) :
+		ExprAST(unary_expr), op(op), operand(std::move(operand)) {}
+	~UnaryExprAST() override;
+	static bool classof(const ExprAST* e) { return e->kind == unary_expr; }
 };
 
-class IntLiteralAST final :public LiteralAST
+class BinaryExprAST final :public ExprAST
 {
 public:
-	std::unique_ptr<int> value = nullptr;
-	IntLiteralAST(std::unique_ptr<int> value) :value(std::move(value)) {}
+	int op;		// symbol_mark
+	std::unique_ptr<ExprAST> lhs;
+	std::unique_ptr<ExprAST> rhs;
+	BinaryExprAST(int op, std::unique_ptr<ExprAST> lhs, std::unique_ptr<ExprAST> rhs) :
+		ExprAST(binary_expr), op(op), lhs(std::move(lhs)), rhs(std::move(rhs)) {}
+	~BinaryExprAST() override;
+	static bool classof(const ExprAST* e) { return e->kind == binary_expr; }
 };
 
-class DoubleLiteralAST final : public LiteralAST
+// operands joined by AND (&&) or by OR (||); a AND b AND c is one node
+class LogicalExprAST final :public ExprAST
 {
 public:
-	std::unique_ptr<double> value = nullptr;
-	DoubleLiteralAST(std::unique_ptr<double> value) :value(std::move(value)) {}
+	int op;		// tok_AND or tok_OR
+	llvm::SmallVector<std::unique_ptr<ExprAST>, 4> operands;
+	LogicalExprAST(int op, std::unique_ptr<ExprAST> lhs, std::unique_ptr<ExprAST> rhs) :
+		ExprAST(logical_expr), op(op)
+	{
+		operands.push_back(std::move(lhs));
+		operands.push_back(std::move(rhs));
+	}
+	~LogicalExprAST() override;
+	static bool classof(const ExprAST* e) { return e->kind == logical_expr; }
 };
 
-class StringLiteralAST final :public LiteralAST
+// operand IS [NOT] NULL
+class IsNullAST final :public ExprAST
 {
 public:
-	std::unique_ptr<std::string> value = nullptr;
-	StringLiteralAST(std::unique_ptr<std::string> value) :value(std::move(value)) {}
-	
+	bool negated;
+	std::unique_ptr<ExprAST> operand;
+	IsNullAST(std::unique_ptr<ExprAST> operand, bool negated) :
+		ExprAST(is_null_expr), negated(negated), operand(std::move(operand)) {}
+	static bool classof(const ExprAST* e) { return e->kind == is_null_expr; }
 };
 
-class ParenExprAST final :public SimpleExprAST
+// operand [NOT] IN (list)
+// A list of literals of one kind, the usual case and often thousands long,
+// is one array in the arena: ints, doubles or strings as values_kind says.
+// Any other list is kept as nodes in list.
+class InListAST final :public ExprAST
 {
 public:
-	std::unique_ptr<ExprAST> expr;
-	ParenExprAST(std::unique_ptr<ExprAST> expr) :
-		expr(std::move(expr)) {}
+	bool negated;
+	expr_kind values_kind = int_expr;
+	std::unique_ptr<ExprAST> operand;
+	llvm::ArrayRef<std::int64_t> ints;
+	llvm::ArrayRef<double> doubles;
+	llvm::ArrayRef<llvm::StringRef> strings;
+	std::vector<std::unique_ptr<ExprAST>> list;
+	InListAST(std::unique_ptr<ExprAST> operand, bool negated) :
+		ExprAST(in_list_expr), negated(negated), operand(std::move(operand)) {}
+	std::size_t size() const { return list.size() + ints.size() + doubles.size() + strings.size(); }
+	static bool classof(const ExprAST* e) { return e->kind == in_list_expr; }
 };
 
-class SubqueryAST final :public SimpleExprAST
+class SubqueryAST final :public ExprAST
 {
 	//	handle select * from CASE
 	bool distinct_flag = false;
@@ -1142,6 +1221,7 @@ public:
 		bool group_flag, bool group_ASC, std::vector<table_col> groupby_col_name,
 		bool order_flag, bool order_ASC, std::vector<table_col> orderby_col_name
 	) :
+		ExprAST(subquery_expr),
 		distinct_flag(distinct_flag), exprs(std::move(exprs)),
 		from_flag(from_flag), tbrefs(std::move(tbrefs)),
 		where_flag(where_flag), wherecond(std::move(wherecond)),
@@ -1149,51 +1229,105 @@ public:
 		group_flag(group_flag), group_ASC(group_ASC), groupby_col_name(std::move(groupby_col_name)),
 		order_flag(order_flag), order_ASC(order_ASC), orderby_col_name(std::move(orderby_col_name))
 	{}
+	static bool classof(const ExprAST* e) { return e->kind == subquery_expr; }
 };
 
-class ExistsSubqueryAST final :public SimpleExprAST
+class ExistsSubqueryAST final :public ExprAST
 {
+public:
 	std::unique_ptr<SubqueryAST> subquery;
+	ExistsSubqueryAST(std::unique_ptr<SubqueryAST> subquery) :
+		ExprAST(exists_expr), subquery(std::move(subquery)) {}
+	static bool classof(const ExprAST* e) { return e->kind == exists_expr; }
+};
+
+// ? in a prepared statement; index counts them from 0 in the order they appear
+class ParamAST final :public ExprAST
+{
 public:
-	ExistsSubqueryAST(std::unique_ptr<SubqueryAST> subquery) :subquery(std::move(subquery)) {}
+	unsigned index;
+	ParamAST(unsigned index) :ExprAST(param_expr), index(index) {}
+	static bool classof(const ExprAST* e) { return e->kind == param_expr; }
 };
 
+class ColdefAST :public ast_node
+{
+public:
+	atom col_name = no_atom;
+	int dtype = 0;
+	bool nullable = true;
+	bool unique = false;
+	bool primary = false;
+	int n ;
+	ColdefAST() = default;
+	ColdefAST(atom col_name, int dtype, bool nullable, bool unique, bool primary) :
+		col_name(col_name), dtype(dtype), nullable(nullable), unique(unique), primary(primary) {}
+	ColdefAST(atom col_name, int dtype, bool nullable, bool unique, bool primary, int n) :
+		col_name(col_name), dtype(dtype), nullable(nullable), unique(unique), primary(primary), n(n) {}
+};
 
+// operand [NOT] IN (SELECT ...)
+class InSubqueryAST final :public ExprAST
+{
+public:
+	bool negated;
+	std::unique_ptr<ExprAST> operand;
+	std::unique_ptr<SubqueryAST> sub;
+	InSubqueryAST(std::unique_ptr<ExprAST> operand, std::unique_ptr<SubqueryAST> sub, bool negated) :
+		ExprAST(in_subquery_expr), negated(negated), operand(std::move(operand)), sub(std::move(sub)) {}
+	static bool classof(const ExprAST* e) { return e->kind == in_subquery_expr; }
+};
 
+// lhs op ALL|ANY (SELECT ...)
+class QuantifiedExprAST final :public ExprAST
+{
+public:
+	int op;				// comparison symbol_mark
+	int quantifier;		// tok_ALL or tok_ANY
+	std::unique_ptr<ExprAST> lhs;
+	std::unique_ptr<SubqueryAST> sub;
+	QuantifiedExprAST(int op, int quantifier, std::unique_ptr<ExprAST> lhs, std::unique_ptr<SubqueryAST> sub) :
+		ExprAST(quantified_expr), op(op), quantifier(quantifier), lhs(std::move(lhs)), sub(std::move(sub)) {}
+	static bool classof(const ExprAST* e) { return e->kind == quantified_expr; }
+};
 
 
 
-class SelectExprAST
+
+
+
+class SelectExprAST :public ast_node
 {
 public:
 	std::unique_ptr<ExprAST> expr;
-	std::unique_ptr<std::string> alias;
-	SelectExprAST(std::unique_ptr<ExprAST> expr, std::unique_ptr<std::string> alias) :
-		expr(std::move(expr)), alias(std::move(alias)) {}
+	atom alias;
+	SelectExprAST(std::unique_ptr<ExprAST> expr, atom alias) :
+		expr(std::move(expr)), alias(alias) {}
 
 };
 
 
 
-class TableRefsAST
+class TableRefsAST :public ast_node
 {
 public:
 	std::vector<std::unique_ptr<TableRefAST>> refs;
 	TableRefsAST(std::vector<std::unique_ptr<TableRefAST>> refs) :refs(std::move(refs)) {}
 };
 
-class TableRefAST
+class TableRefAST :public ast_node
 {
 public:
-	std::string topalias;
+	atom topalias = no_atom;
+	virtual ~TableRefAST() = default;
 	TableRefAST() = default;
-	TableRefAST(const std::string& topalias) :topalias(topalias) {}
+	TableRefAST(atom topalias) :topalias(topalias) {}
 };
 
-class JoinCondAST
+class JoinCondAST :public ast_node
 {
 public:
-
+	virtual ~JoinCondAST() = default;
 };
 
 class TableFactorAST :public TableRefAST
@@ -1210,16 +1344,16 @@ public://
 class TableNameAST final :public TableFactorAST
 {
 public:
-	std::string name;
-	TableNameAST(const std::string& name) :name(name) {}
+	atom name;
+	TableNameAST(atom name) :name(name) {}
 };
 
 class TableQueryAST final :public TableFactorAST
 {
 public:
-	std::string alias;
+	atom alias;
 	std::unique_ptr<SubqueryAST> subq;
-	TableQueryAST(const std::string& alias, std::unique_ptr<SubqueryAST> subq) :
+	TableQueryAST(atom alias, std::unique_ptr<SubqueryAST> subq) :
 		alias(alias), subq(std::move(subq)) {}
 
 };
@@ -1298,104 +1432,211 @@ public:
 
 
 
+/// stmt_kind - what a StatementAST is, for llvm::isa/cast/dyn_cast like expr_kind
+enum stmt_kind : std::uint8_t
+{
+	select_stmt,
+	insert_stmt,
+	delete_stmt,
+	create_table_stmt,
+	create_table_select_stmt,
+	create_table_like_stmt,
+	create_index_stmt,
+	drop_table_stmt,
+	drop_index_stmt,
+	prepare_stmt,
+	execute_stmt,
+	deallocate_stmt
+};
+
+// the statement itself is on the heap and owns the arena its nodes are in;
+// members of derived classes are destroyed before arena
 class StatementAST
 {
 public:
+	stmt_kind kind;
+	unsigned params = 0;	// ? placeholders, ParamAST::index runs below this
+	std::unique_ptr<ast_arena> arena;
+	explicit StatementAST(stmt_kind kind) :kind(kind) {}
 	virtual ~StatementAST() = default;
 };
 
 class CreateAST :public StatementAST
 {
-	;
+public:
+	explicit CreateAST(stmt_kind kind) :StatementAST(kind) {}
 };
 
 class CreateTableAST :public CreateAST
 {
-	;
+public:
+	explicit CreateTableAST(stmt_kind kind) :CreateAST(kind) {}
 };
 
 class CreateTableSimpleAST :public CreateTableAST
 {
-	std::string table_name; 
-	std::vector<std::unique_ptr<ColdefAST>> create_defs;
 public:
-	CreateTableSimpleAST(const std::string table_name,std::vector<std::unique_ptr<ColdefAST>> create_defs) :
-		table_name(table_name), create_defs(std::move(create_defs)) {}
+	atom table_name;
+	std::vector<std::unique_ptr<ColdefAST>> create_defs;	// null for a column type not supported yet
+
+	CreateTableSimpleAST(atom table_name,std::vector<std::unique_ptr<ColdefAST>> create_defs) :
+		CreateTableAST(create_table_stmt), table_name(table_name), create_defs(std::move(create_defs)) {}
 	~CreateTableSimpleAST() = default;
+	static bool classof(const StatementAST* s) { return s->kind == create_table_stmt; }
 };
 
 class CreateTableSelectAST :public CreateTableAST
 {
-	std::string table_name;
+	atom table_name;
 public:
-	CreateTableSelectAST(const std::string& table_name) :
-		table_name(table_name) {}
+	CreateTableSelectAST(atom table_name) :
+		CreateTableAST(create_table_select_stmt), table_name(table_name) {}
+	static bool classof(const StatementAST* s) { return s->kind == create_table_select_stmt; }
 };
 
 class CreateTableLikeAST :public CreateTableAST
 {
-	std::string table_name;
-	std::string old_name;
+	atom table_name;
+	atom old_name;
 public:
-	CreateTableLikeAST(const std::string& table_name, const std::string& old_name) :
-		table_name(table_name), old_name(old_name) {}
+	CreateTableLikeAST(atom table_name, atom old_name) :
+		CreateTableAST(create_table_like_stmt), table_name(table_name), old_name(old_name) {}
+	static bool classof(const StatementAST* s) { return s->kind == create_table_like_stmt; }
 };
 
 class CreateIndexAST :public CreateAST
 {
-	std::string index_name;
-	std::string table_name;
-	std::string col_name;
+	atom index_name;
+	atom table_name;
+	atom col_name;
 public:
-	CreateIndexAST(const std::string& index_name, const std::string& table_name, const std::string& col_name) :
-		index_name(index_name), table_name(table_name), col_name(col_name) {}
+	CreateIndexAST(atom index_name, atom table_name, atom col_name) :
+		CreateAST(create_index_stmt), index_name(index_name), table_name(table_name), col_name(col_name) {}
+	static bool classof(const StatementAST* s) { return s->kind == create_index_stmt; }
 };
 
-class DropAST :public StatementAST {};
+class DropAST :public StatementAST
+{
+public:
+	explicit DropAST(stmt_kind kind) :StatementAST(kind) {}
+};
 
 class DropTableAST :public DropAST
 {
-	std::vector<std::string> table_list;
+	std::vector<atom> table_list;
 
 public:
-	DropTableAST(std::vector<std::string> table_list) : table_list(std::move(table_list)) {}
+	DropTableAST(std::vector<atom> table_list) :DropAST(drop_table_stmt), table_list(std::move(table_list)) {}
+	static bool classof(const StatementAST* s) { return s->kind == drop_table_stmt; }
 };
 
 class DropIndexAST :public DropAST
 {
-	std::string index_name;
-	std::string table_name;
+	atom index_name;
+	atom table_name;
 public:
-	DropIndexAST(const std::string& index_name, const std::string& table_name) :
-		index_name(std::move(index_name)), table_name(std::move(table_name)) {}
+	DropIndexAST(atom index_name, atom table_name) :
+		DropAST(drop_index_stmt), index_name(index_name), table_name(table_name) {}
+	static bool classof(const StatementAST* s) { return s->kind == drop_index_stmt; }
 };
 
+// a value of a bulk INSERT that is not a literal, see insert_column
+class insert_expr
+{
+public:
+	std::uint32_t row;
+	std::unique_ptr<ExprAST> value;
+	insert_expr(std::uint32_t row, std::unique_ptr<ExprAST> value) :row(row), value(std::move(value)) {}
+};
+
+/// insert_column - one target column of an INSERT into a table of known schema
+/// Holds a value per row in the type the column was declared with: ints,
+/// doubles or strings (in the statement's arena) as dtype says.  A value
+/// that is not a literal of that type (an int will do for DOUBLE) is in
+/// exprs instead and its slot holds 0 or "".  That includes every ?, whose
+/// value is only known once bound (prepared statements, statement_cache).
+class insert_column
+{
+public:
+	atom name = no_atom;
+	int dtype = blank;
+	int width = 0;		// CHAR(n), not checked here
+	std::vector<std::int64_t> ints;
+	std::vector<double> doubles;
+	std::vector<llvm::StringRef> strings;
+	std::vector<insert_expr> exprs;		// by row
+};
+
+// INSERT INTO table [(col, ...)] VALUES (...), ...
+// Parsed with the table's schema at hand the rows are in columns, one per
+// target column, and value_list is empty; without it every value is a node
+// in value_list, rows one after another.
 class InsertAST :public StatementAST
 {
-	std::string table_name;
-	std::vector<std::string> col_name;
-	std::vector<std::unique_ptr<ExprAST>> value_list;
 public:
-	InsertAST(const std::string& table_name, std::vector<std::string>col_name, std::vector<std::unique_ptr<ExprAST>> value_list) :
-		table_name(table_name), col_name(std::move(col_name)), value_list(std::move(value_list)) {}
+	atom table_name;
+	std::vector<atom> col_name;
+	std::vector<std::unique_ptr<ExprAST>> value_list;
+	std::vector<insert_column> columns;
+	std::size_t rows = 0;
+	InsertAST(atom table_name, std::vector<atom>col_name, std::vector<std::unique_ptr<ExprAST>> value_list) :
+		StatementAST(insert_stmt), table_name(table_name), col_name(std::move(col_name)), value_list(std::move(value_list)) {}
+	InsertAST(atom table_name, std::vector<atom>col_name, std::vector<insert_column> columns, std::size_t rows) :
+		StatementAST(insert_stmt), table_name(table_name), col_name(std::move(col_name)), columns(std::move(columns)), rows(rows) {}
+	static bool classof(const StatementAST* s) { return s->kind == insert_stmt; }
 };
 
 class DeleteAST :public StatementAST
 {
-	std::string table_name;
+	atom table_name;
 	std::unique_ptr< ExprAST> where_condition;
 public:
-	DeleteAST(const std::string& table_name, std::unique_ptr<ExprAST>where_condition) :
-		table_name(table_name), where_condition(std::move(where_condition)) {}
+	DeleteAST(atom table_name, std::unique_ptr<ExprAST>where_condition) :
+		StatementAST(delete_stmt), table_name(table_name), where_condition(std::move(where_condition)) {}
+	static bool classof(const StatementAST* s) { return s->kind == delete_stmt; }
 };
 
 class SelectAST :public StatementAST
 {
 	std::unique_ptr<SubqueryAST> subquery;
+public:
+	SelectAST(std::unique_ptr<SubqueryAST> subquery) :StatementAST(select_stmt), subquery(std::move(subquery)) {}
+	static bool classof(const StatementAST* s) { return s->kind == select_stmt; }
+};
+
+// PREPARE name FROM 'statement'
+class PrepareAST :public StatementAST
+{
+public:
+	atom name;
+	llvm::StringRef text;	// in the arena
+	PrepareAST(atom name, llvm::StringRef text) :StatementAST(prepare_stmt), name(name), text(text) {}
+	static bool classof(const StatementAST* s) { return s->kind == prepare_stmt; }
+};
+
+// EXECUTE name [USING value, ...]
+class ExecuteAST :public StatementAST
+{
+public:
+	atom name;
+	std::vector<std::unique_ptr<ExprAST>> args;
+	ExecuteAST(atom name, std::vector<std::unique_ptr<ExprAST>> args) :
+		StatementAST(execute_stmt), name(name), args(std::move(args)) {}
+	static bool classof(const StatementAST* s) { return s->kind == execute_stmt; }
+};
+
+// {DEALLOCATE | DROP} PREPARE name
+class DeallocateAST :public StatementAST
+{
+public:
+	atom name;
+	DeallocateAST(atom name) :StatementAST(deallocate_stmt), name(name) {}
+	static bool classof(const StatementAST* s) { return s->kind == deallocate_stmt; }
 };
 
 
 void init_scanner();
+void set_source(std::unique_ptr<scan_source> src);
 void init_parser();
 
 
@@ -13,11 +13,14 @@
 #include <cctype>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 #include"llvmsql.h"
+#include"incremental.h"
+#include"prepared.h"
 
 
 using namespace llvm;
@@ -143,14 +146,14 @@ namespace {
 		Value *codegen() override;
 	};
 
-	/// BinaryExprAST - Expression class for a binary operator.
-	class BinaryExprAST : public exprAST 
+	/// binaryExprAST - Expression class for a binary operator.
+	class binaryExprAST : public exprAST 
 	{
 		char Op;
 		std::unique_ptr<exprAST> LHS, RHS;
 
 	public:
-		BinaryExprAST(char Op, std::unique_ptr<exprAST> LHS,
+		binaryExprAST(char Op, std::unique_ptr<exprAST> LHS,
 			std::unique_ptr<exprAST> RHS)
 			: Op(Op), LHS(std::move(LHS)), RHS(std::move(RHS)) {}
 
@@ -357,7 +360,7 @@ static std::unique_ptr<exprAST> ParseBinOpRHS(int ExprPrec,std::unique_ptr<exprA
 
 		// Merge LHS/RHS.
 		LHS =
-			llvm::make_unique<BinaryExprAST>(BinOp, std::move(LHS), std::move(RHS));
+			llvm::make_unique<binaryExprAST>(BinOp, std::move(LHS), std::move(RHS));
 	}
 }
 
@@ -464,7 +467,7 @@ Value *VariableExprAST::codegen()
 	return V;
 }
 
-Value *BinaryExprAST::codegen()
+Value *binaryExprAST::codegen()
 {
 	Value *L = LHS->codegen();
 	Value *R = RHS->codegen();
@@ -648,12 +651,55 @@ static void MainLoop()
 	}
 }
 
+/// SQL shell: the input is kept as one incremental_script, each line is
+/// appended and only the statements it completed are parsed, then dropped
+static void SQLMainLoop()
+{
+	incremental_script script;
+	prepared_session prepared;
+	char line[4096];
+	fprintf(stderr, "YSQL> ");
+	while (fgets(line, sizeof line, stdin))
+	{
+		script.append(line);
+		bool pending = script.take_complete([&](const incremental_script::statement& s)
+		{
+			if (!s.error.empty())
+				fprintf(stderr, "error: %s\n", s.error.c_str());
+			else if (s.ast)
+			{
+				try
+				{
+					prepared.run(*s.ast);
+					fprintf(stderr, "ok\n");
+				}
+				catch (prepare_error& e)
+				{
+					fprintf(stderr, "error: %s\n", e.what());
+				}
+				catch (syntax_error& e)
+				{
+					fprintf(stderr, "error in prepared statement: %s\n", e.what());
+				}
+			}
+		});
+		// what ran is not needed again, the script keeps only what is pending
+		script.drop_taken();
+		fprintf(stderr, pending ? "    > " : "YSQL> ");
+	}
+}
+
 //===----------------------------------------------------------------------===//
 // Main driver code.
 //===----------------------------------------------------------------------===//
 
-int main()
+int main(int argc, char** argv)
 {
+	if (argc > 1 && strcmp(argv[1], "--sql") == 0)
+	{
+		SQLMainLoop();
+		return 0;
+	}
 	init_scanner();
 	std::unique_ptr<ExprAST> x;
 	init_parser();
@@ -0,0 +1,100 @@
+#pragma once
+
+#ifndef llvmsql_prepared
+#define llvmsql_prepared
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+#include"llvmsql.h"
+
+/// prepare_error - a prepared statement used the wrong way: a ? left
+/// unbound, the wrong number of values, an unknown name
+class prepare_error :public std::runtime_error
+{
+public:
+	explicit prepare_error(const std::string& what) :std::runtime_error(what) {}
+};
+
+/// param_value - what is bound to one ?
+/// type is literal_int, literal_double or literal_string, as in
+/// ColdefAST::dtype, and blank while nothing is bound.
+class param_value
+{
+public:
+	int type = blank;
+	std::int64_t int_value = 0;
+	double double_value = 0;
+	std::string string_value;	// kept between binds, rebinding reuses its buffer
+};
+
+/// bound_statement - one run of a prepared statement
+/// The AST parsed at prepare time and the values bound for this run; an
+/// executor reads a ParamAST as values[param.index].
+struct bound_statement
+{
+	const StatementAST* ast = nullptr;
+	llvm::ArrayRef<param_value> values;
+	const param_value& operator[](const ParamAST& p) const { return values[p.index]; }
+};
+
+/// prepared_statement - parse once, bind and execute many times
+/// The text is lexed and parsed in the constructor and never again; a run
+/// only stores values in the slots of its ?s.
+///
+///   prepared_statement insert("INSERT INTO t VALUES (?, ?)");
+///   insert.bind_int(0, 42);
+///   insert.bind_string(1, "x");
+///   run(insert.execute());
+class prepared_statement
+{
+public:
+	// one statement, a trailing ';' is fine; throws syntax_error or prepare_error
+	explicit prepared_statement(llvm::StringRef sql);
+
+	const StatementAST& statement() const { return *ast; }
+	std::size_t param_count() const { return values.size(); }
+
+	// i counts the ?s from 0; a value stays bound until replaced or cleared
+	void bind_int(std::size_t i, std::int64_t v);
+	void bind_double(std::size_t i, double v);
+	void bind_string(std::size_t i, llvm::StringRef v);
+	void bind(std::size_t i, const param_value& v);
+	void clear_bindings();
+
+	// valid until the next bind; throws prepare_error while a ? is unbound
+	bound_statement execute();
+	std::size_t executions() const { return runs; }
+
+private:
+	std::unique_ptr<StatementAST> ast;
+	std::vector<param_value> values;
+	std::size_t runs = 0;
+
+	param_value& slot(std::size_t i);
+};
+
+/// prepared_session - the statements named by PREPARE in one session
+/// PREPARE name FROM '...' parses the text, EXECUTE name USING ... binds
+/// literals to it and DEALLOCATE PREPARE name drops it.  PREPARE on a name
+/// in use replaces the old statement, and drops it even if the new one fails.
+class prepared_session
+{
+public:
+	// carries out PREPARE, EXECUTE and DEALLOCATE, an EXECUTE leaves what it
+	// runs in *executed; false for any other statement, which the caller runs
+	bool run(const StatementAST& stmt, bound_statement* executed = nullptr);
+	prepared_statement* find(atom name);
+	std::size_t size() const { return named.size(); }
+
+private:
+	std::unordered_map<atom, std::unique_ptr<prepared_statement>> named;
+};
+
+#endif
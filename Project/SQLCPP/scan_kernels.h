@@ -0,0 +1,37 @@
+#pragma once
+
+#ifndef llvmsql_scan_kernels
+#define llvmsql_scan_kernels
+
+/// scan_kernels - bulk byte searches used by gettok() to skip over blanks,
+/// comments and string bodies without going through peek() per byte.
+///
+/// Every kernel scans [p, lim) and returns lim when nothing is found, so the
+/// scanner can refill its window and call again.  The implementation (AVX2,
+/// SSE4.2 or plain C++) is picked once from cpuid; setting LLVMSQL_SCAN_KERNELS
+/// to scalar, sse42 or avx2 overrides the choice for benchmarking.
+struct scan_kernels
+{
+	const char* name;
+
+	// first byte that is not ' ', \t, \n, \v, \f or \r
+	const char* (*skip_space)(const char* p, const char* lim);
+
+	// first '\n' or '\r'
+	const char* (*find_newline)(const char* p, const char* lim);
+
+	// the '*' of the first "*/"; a '*' in the last byte is returned as well
+	// since its '/' may come with the next refill
+	const char* (*find_comment_end)(const char* p, const char* lim);
+
+	// first quote (the one that opened the string literal) or backslash
+	const char* (*find_quote)(const char* p, const char* lim, char quote);
+
+	// first byte that can start a string, a comment or end a statement:
+	// ' " # - / ;  (the pre-pass of lex_parallel)
+	const char* (*find_code_mark)(const char* p, const char* lim);
+};
+
+const scan_kernels& select_scan_kernels();
+
+#endif
@@ -0,0 +1,33 @@
+#pragma once
+
+#ifndef llvmsql_scan_parallel
+#define llvmsql_scan_parallel
+
+#include <cstddef>
+#include <vector>
+#include"llvmsql.h"
+#include"thread_pool.h"
+
+/// Parallel lexing of a whole script held in memory (string or mmap_source).
+///
+/// The input is cut into pieces of about piece_bytes.  A pre-pass, itself
+/// run in parallel, finds for every piece the first ';' that is outside
+/// strings and comments; it follows the same rules as gettok(): ' and "
+/// strings with \ escapes, # and -- to the end of the line, /* ... */.
+/// Since the lexical state at a piece boundary is not known until the pieces
+/// before it are done, each piece is pre-scanned from every state it could
+/// start in, and the real chain of states is resolved afterwards.
+///
+/// The statements between those semicolons are lexed concurrently, one
+/// Scanner each, and stitched into out in source order.
+
+// split points: begin, then one past a top-level ';' per piece that has one, then end
+std::vector<const char*> statement_splits(const char* begin, const char* end, thread_pool& pool,
+	std::size_t piece_bytes = 1 << 18);
+
+// appends the tokens of [begin, end) to out, returns the number added
+// token offsets count from begin; with recover the pieces are lexed as by Scanner::set_recover(true)
+std::size_t lex_parallel(const char* begin, const char* end, token_buffer& out, thread_pool& pool,
+	std::size_t piece_bytes = 1 << 18, bool recover = false);
+
+#endif
@@ -0,0 +1,145 @@
+#pragma once
+
+#ifndef llvmsql_scan_source
+#define llvmsql_scan_source
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 1-based; 0 when the offset is no longer held by the source
+struct source_location
+{
+	unsigned line = 0;
+	unsigned column = 0;
+};
+
+/// scan_source - the byte window gettok() reads from.
+///
+/// [cur, lim) is always a contiguous run of input, so lookahead is plain
+/// pointer arithmetic.  fill(n) is only called when fewer than n bytes are
+/// left in the window; sources that hold the whole input simply return false.
+/// A refilling source may relocate the window, but it never drops bytes at or
+/// after mark (the start of the token being scanned) and fixes up cur/mark.
+///
+/// Positions are byte offsets from the start of the input.  Lines are only
+/// counted when locate() is asked for one: the newlines of the bytes still
+/// held are indexed then, and a refilling source adds up the newlines of the
+/// bytes it drops, so nothing is counted per character while scanning.
+class scan_source
+{
+	std::vector<std::uint64_t> newlines;	// offsets of the '\n's indexed so far
+	std::uint64_t indexed_from = 0, indexed_to = 0;
+public:
+	const char* cur = nullptr;
+	const char* lim = nullptr;
+	const char* mark = nullptr;
+
+	// the first byte still held and its offset in the input
+	const char* origin = nullptr;
+	std::uint64_t origin_offset = 0;
+	// newlines before origin, and where the line holding origin starts
+	std::uint64_t lines_before = 0;
+	std::uint64_t line_start = 0;
+
+	virtual ~scan_source() = default;
+
+	// make at least n bytes readable from cur, false if the input ends first
+	virtual bool fill(std::size_t) { return false; }
+
+	std::uint64_t offset(const char* p) const { return origin_offset + static_cast<std::uint64_t>(p - origin); }
+	source_location locate(std::uint64_t at);
+};
+
+class source_error :public std::runtime_error
+{
+public:
+	explicit source_error(const std::string& s) :
+		std::runtime_error(s) {}
+};
+
+/// string_source - the whole input is an in-memory string
+class string_source :public scan_source
+{
+	std::string text;
+public:
+	explicit string_source(std::string s);
+	string_source(const string_source&) = delete;
+	string_source& operator=(const string_source&) = delete;
+};
+
+/// memory_source - bytes owned by someone else, e.g. one piece of a mapped script
+/// base is the offset of begin in the whole script; a piece that does not
+/// start it also says how many newlines come before it and where its first
+/// line starts, so locate() gives lines of the whole script
+class memory_source :public scan_source
+{
+public:
+	memory_source(const char* begin, const char* end, std::uint64_t base = 0);
+	memory_source(const char* begin, const char* end, std::uint64_t base, std::uint64_t lines_before,
+		std::uint64_t line_start);
+};
+
+/// mmap_source - the whole input is a read-only mapping of a file
+class mmap_source :public scan_source
+{
+	void* base = nullptr;
+	std::size_t size = 0;
+#ifdef _WIN32
+	void* file = nullptr;
+	void* mapping = nullptr;
+#endif
+public:
+	explicit mmap_source(const std::string& path);
+	~mmap_source();
+	mmap_source(const mmap_source&) = delete;
+	mmap_source& operator=(const mmap_source&) = delete;
+};
+
+/// buffered_source - reads a file descriptor in large blocks
+/// read() returns whatever is available, so an interactive stdin still
+/// hands every line to the scanner as soon as it is typed.
+/// The window slides over one buffer instead of wrapping around, so [cur, lim)
+/// stays contiguous; the buffer only grows when a single token outruns half of
+/// it, which keeps memory flat however long the input is.
+class buffered_source :public scan_source
+{
+	bool at_eof = false;
+	std::vector<char> buf;
+protected:
+	int fd;
+
+	// up to n bytes of input into dst, 0 at the end of input
+	virtual std::size_t read_some(char* dst, std::size_t n);
+public:
+	explicit buffered_source(int fd, std::size_t block = 1 << 16);
+	bool fill(std::size_t n) override;
+};
+
+/// compressed_source - a gzip or zstd stream decompressed on the fly
+/// The format is taken from the magic bytes; concatenated gzip members and
+/// zstd frames are read one after another.  Only a block of compressed input
+/// and the scanner window are held, so multi-GB dumps scan in constant memory.
+/// zstd needs the build to define LLVMSQL_WITH_ZSTD and link libzstd.
+class compressed_source :public buffered_source
+{
+	struct codec;
+	std::unique_ptr<codec> dec;
+	bool owns_fd;
+protected:
+	std::size_t read_some(char* dst, std::size_t n) override;
+public:
+	explicit compressed_source(int fd, bool owns_fd = false, std::size_t block = 1 << 16);
+	~compressed_source();
+	compressed_source(const compressed_source&) = delete;
+	compressed_source& operator=(const compressed_source&) = delete;
+};
+
+// a file by name: compressed_source for .gz/.zst content, mmap_source otherwise
+std::unique_ptr<scan_source> open_source(const std::string& path);
+
+#endif
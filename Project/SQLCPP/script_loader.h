@@ -0,0 +1,59 @@
+#pragma once
+
+#ifndef llvmsql_script_loader
+#define llvmsql_script_loader
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include"llvmsql.h"
+#include"catalog.h"
+#include"thread_pool.h"
+
+/// script_loader - a whole script parsed on a thread_pool, run in order
+///
+/// The script is lexed with lex_parallel and cut at its semicolons.  Its
+/// CREATE statements are parsed first, one after another: an INSERT parses
+/// into typed columns once its table is known (Parser::set_catalog), so each
+/// INSERT is given the table as the CREATEs before it in the script left it.
+/// Then batches of statements are parsed concurrently, a Parser each over the
+/// shared token buffer, and handed to execute in source order as soon as the
+/// batches before them are done, while later ones are still being parsed.
+/// Only about two batches per worker are parsed ahead of execute, and each
+/// statement is released once execute returns, so run() holds the script's
+/// tokens but not all of its ASTs; load() is the one that keeps them.
+///
+/// The catalog passed in says what tables exist before the script; the
+/// loader applies each CREATE TABLE to it just before that statement is
+/// executed, never while parsing.
+class script_loader
+{
+public:
+	struct statement
+	{
+		std::uint64_t offset = 0;		// of its first token
+		std::unique_ptr<StatementAST> ast;
+		std::string error;				// lexical or syntax error, ast is null then
+	};
+
+	explicit script_loader(thread_pool& pool, schema_catalog* catalog = nullptr) :pool(pool), catalog(catalog) {}
+
+	// execute(s) for every statement of [begin, end) in source order, returns
+	// how many; s is reset when execute returns, so keep what it needs by
+	// moving it out; an exception from execute stops the run and is rethrown
+	std::size_t run(const char* begin, const char* end, const std::function<void(statement&)>& execute);
+	// all of them at once
+	std::vector<statement> load(const char* begin, const char* end);
+
+	std::size_t batch_tokens = 1 << 14;		// tokens parsed by one job, at least
+	std::size_t piece_bytes = 1 << 18;		// for lex_parallel
+
+private:
+	thread_pool& pool;
+	schema_catalog* catalog;
+};
+
+#endif
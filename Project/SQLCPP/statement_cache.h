@@ -0,0 +1,91 @@
+#pragma once
+
+#ifndef llvmsql_statement_cache
+#define llvmsql_statement_cache
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include"llvmsql.h"
+#include"catalog.h"
+#include"prepared.h"
+
+/// statement_cache - parsed templates of recent statements, keyed by shape
+///
+/// Most statements an application sends differ only in their literals.  As a
+/// statement is lexed, its tokens are hashed with each literal (a run of
+/// adjacent strings is one) replaced by a placeholder, and the literal values
+/// are collected.  The first statement of a shape is parsed with a ? in place
+/// of every literal and the result kept; later ones of that shape get the
+/// kept template with their own values bound, and are not parsed at all.
+/// When capacity shapes are kept the least recently used one goes.
+///
+/// Only SELECT, INSERT and DELETE with at most max_params literals are
+/// templated.  Anything else, and a shape whose template does not parse
+/// (the grammar wanted a literal token there), is parsed as written.
+///
+/// A ? is not a literal, so a template puts no values in typed INSERT columns
+/// or IN list arrays: each ? is a ParamAST in insert_column::exprs or the IN
+/// list, and its value is in bound_statement::values.  A multi-row INSERT
+/// with more than max_params literals is parsed as written, into the columns.
+///
+/// One cache per thread or session; it is not locked.
+class statement_cache
+{
+public:
+	explicit statement_cache(std::size_t capacity = 256, std::size_t max_params = 256);
+
+	// the next statement of scanner, through its ';'; ast is null at the end
+	// of input.  Valid until the next call.  Throws what Parser throws, and
+	// prepare_error for a ? written in the statement.
+	bound_statement next(Scanner& scanner);
+	// the statement in tokens [first, first + count)
+	bound_statement get(const token_buffer& tokens, std::size_t first, std::size_t count);
+
+	std::size_t size() const { return entries.size(); }
+	void clear();
+
+	// INSERT into a table found here is parsed into typed columns (see above);
+	// templates are dropped whenever its tables change.  It must outlive the cache
+	void set_catalog(const schema_catalog* tables);
+
+	std::size_t hits = 0;		// bound to a kept template
+	std::size_t misses = 0;		// new shape, parsed and kept
+	std::size_t uncached = 0;	// parsed as written
+	std::size_t evictions = 0;
+
+private:
+	struct entry
+	{
+		std::uint64_t hash;
+		std::vector<std::int64_t> shape;
+		std::unique_ptr<StatementAST> ast;	// null: this shape is parsed as written
+	};
+	std::size_t capacity;
+	std::size_t max_params;
+	const schema_catalog* catalog = nullptr;
+	std::uint64_t catalog_version = 0;		// of the tables the templates saw
+	std::list<entry> entries;	// most recently used first
+	std::unordered_map<std::uint64_t, std::list<entry>::iterator> index;
+
+	// the statement being looked up
+	token_buffer own;
+	token_buffer with_params;
+	std::vector<std::int64_t> shape;
+	std::uint64_t hash = 0;
+	std::vector<param_value> values;
+	std::size_t literals = 0;
+	bool in_string = false;
+	bool templated = true;
+	std::unique_ptr<StatementAST> as_written;
+
+	void start();
+	void add(const token_buffer& tokens, std::size_t i);
+	bound_statement finish(const token_buffer& tokens, std::size_t first, std::size_t count);
+	bound_statement parse_as_written(const token_buffer& tokens, std::size_t first);
+};
+
+#endif
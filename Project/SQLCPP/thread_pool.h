@@ -0,0 +1,100 @@
+#pragma once
+
+#ifndef llvmsql_thread_pool
+#define llvmsql_thread_pool
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// thread_pool - a fixed set of workers draining one job queue
+/// Jobs are plain closures; submit() hands back a future so exceptions thrown
+/// by a job (scan_error and friends) reach whoever waits for it.
+class thread_pool
+{
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> jobs;
+	std::mutex lock;
+	std::condition_variable wake;
+	bool stopping = false;
+
+	void work()
+	{
+		while (true)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> hold(lock);
+				wake.wait(hold, [this] { return stopping || !jobs.empty(); });
+				if (jobs.empty())
+					return;
+				job = std::move(jobs.front());
+				jobs.pop_front();
+			}
+			job();
+		}
+	}
+
+public:
+	// 0 means one worker per hardware thread
+	explicit thread_pool(unsigned threads = 0)
+	{
+		if (threads == 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		for (unsigned i = 0; i < threads; ++i)
+			workers.emplace_back([this] { work(); });
+	}
+
+	~thread_pool()
+	{
+		{
+			std::lock_guard<std::mutex> hold(lock);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (auto& w : workers)
+			w.join();
+	}
+
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+
+	std::size_t size() const { return workers.size(); }
+
+	template<class F>
+	std::future<void> submit(F f)
+	{
+		auto task = std::make_shared<std::packaged_task<void()>>(std::move(f));
+		std::future<void> done = task->get_future();
+		{
+			std::lock_guard<std::mutex> hold(lock);
+			jobs.emplace_back([task] { (*task)(); });
+		}
+		wake.notify_one();
+		return done;
+	}
+
+	// f(i) for every i in [0, n); waits for all of them and rethrows the
+	// first failure in index order
+	template<class F>
+	void parallel_for(std::size_t n, F f)
+	{
+		std::vector<std::future<void>> done;
+		done.reserve(n);
+		for (std::size_t i = 0; i < n; ++i)
+			done.push_back(submit([&f, i] { f(i); }));
+		for (auto& d : done)
+			d.wait();
+		for (auto& d : done)
+			d.get();
+	}
+};
+
+#endif